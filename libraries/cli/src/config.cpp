@@ -6,6 +6,7 @@
 
 #include "cli/config_updater.hpp"
 #include "cli/tools.hpp"
+#include "common/config_exception.hpp"
 #include "common/jsoncpp.hpp"
 #include "config/version.hpp"
 
@@ -49,6 +50,7 @@ Config::Config(int argc, const char* argv[]) {
   bool enable_debug = false;
   bool migrate_only = false;
   bool fix_trx_period = false;
+  bool rebuild_log_index = false;
 
   // Set node as default command
   command.push_back(NODE_COMMAND);
@@ -138,6 +140,8 @@ Config::Config(int argc, const char* argv[]) {
                                      "Only migrate DB, it will NOT run a node");
   node_command_options.add_options()(FIX_TRX_PERIOD, bpo::bool_switch(&fix_trx_period),
                                      "Fix transactions period field. This will take at least few hours");
+  node_command_options.add_options()(REBUILD_LOG_INDEX, bpo::bool_switch(&rebuild_log_index),
+                                     "Rebuilds log index from all stored receipts. Requires log_index enabled in db_config");
 
   allowed_options.add(main_options);
 
@@ -274,6 +278,11 @@ Config::Config(int argc, const char* argv[]) {
     node_config_.db_config.rebuild_db_period = rebuild_db_period;
     node_config_.db_config.migrate_only = migrate_only;
     node_config_.db_config.fix_trx_period = fix_trx_period;
+    if (rebuild_log_index && !node_config_.db_config.log_index) {
+      throw ConfigException(std::string("--") + REBUILD_LOG_INDEX +
+                            " requires log_index to be enabled in db_config of the config file");
+    }
+    node_config_.db_config.rebuild_log_index = rebuild_log_index;
 
     node_config_.enable_test_rpc = enable_test_rpc;
     node_config_.enable_debug = enable_debug;
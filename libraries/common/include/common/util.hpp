@@ -81,6 +81,16 @@ unsigned long getCurrentTimeMilliSeconds();
 
 std::string getFormattedVersion(std::initializer_list<uint32_t> list);
 
+/**
+ * @brief Splits [0, count) range to chunks of at least min_per_task items and processes them on the pool, calling
+ * thread processes the first chunk itself and waits for the rest. If pool is null or range is too small, whole range
+ * is processed on calling thread. Exception thrown by any chunk is rethrown on calling thread
+ *
+ * @param fn processes [begin, end) range
+ */
+void runInChunks(boost::asio::thread_pool *pool, uint32_t pool_threads, size_t count, size_t min_per_task,
+                 const std::function<void(size_t, size_t)> &fn);
+
 /**
  * simple thread_safe hash
  * LRU
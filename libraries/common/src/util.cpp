@@ -1,5 +1,7 @@
 #include "common/util.hpp"
 
+#include <latch>
+
 namespace taraxa {
 
 std::string jsonToUnstyledString(const Json::Value &value) {
@@ -38,4 +40,42 @@ std::vector<uint64_t> asUInt64Vector(const Json::Value &json) {
                  [](const Json::Value &item) { return item.asUInt64(); });
   return v;
 }
+
+void runInChunks(boost::asio::thread_pool *pool, uint32_t pool_threads, size_t count, size_t min_per_task,
+                 const std::function<void(size_t, size_t)> &fn) {
+  // Calling thread processes the first chunk itself
+  const auto tasks_count = pool ? std::min<size_t>(pool_threads + 1, count / min_per_task) : 0;
+  if (tasks_count < 2) {
+    fn(0, count);
+    return;
+  }
+
+  const auto chunk_size = (count + tasks_count - 1) / tasks_count;
+  std::latch done((count - 1) / chunk_size);
+  // Exceptions are rethrown on calling thread after all chunks are done, chunks still reference local state
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  for (auto begin = chunk_size; begin < count; begin += chunk_size) {
+    const auto end = std::min(begin + chunk_size, count);
+    boost::asio::post(*pool, [&fn, &done, &error, &error_mutex, begin, end] {
+      try {
+        fn(begin, end);
+      } catch (...) {
+        std::unique_lock lock(error_mutex);
+        error = std::current_exception();
+      }
+      done.count_down();
+    });
+  }
+  try {
+    fn(0, chunk_size);
+  } catch (...) {
+    std::unique_lock lock(error_mutex);
+    error = std::current_exception();
+  }
+  done.wait();
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
 }  // namespace taraxa
@@ -7,16 +7,60 @@
 
 namespace taraxa {
 
+struct DbColumnProfile {
+  // Bits per key of the bloom filter, 0 disables bloom filter
+  uint32_t bloom_bits_per_key = 0;
+  // Size of uncompressed data block, 0 means rocksdb default (4KB)
+  uint32_t block_size_kb = 0;
+  // Size of block cache shared by all columns using this profile, 0 means rocksdb default cache
+  uint32_t block_cache_mb = 0;
+  // Compression type for each level ("none", "snappy", "lz4", "lz4hc", "zstd"), empty means column default
+  std::vector<std::string> compression_per_level;
+  // Length of fixed key prefix used for prefix bloom filters, 0 disables prefix extractor.
+  // Should be used only for columns that are not iterated across different prefixes
+  uint32_t prefix_length = 0;
+};
+
+struct RocksDbConfig {
+  static inline const std::vector<std::string> kSupportedCompressions = {"none", "snappy", "lz4", "lz4hc", "zstd"};
+
+  // Size of block cache shared by all columns that do not have own profile cache, 0 means rocksdb default cache
+  // for each column
+  uint32_t block_cache_mb = 0;
+  // Size of row cache shared by all columns, 0 disables row cache
+  uint32_t row_cache_mb = 0;
+  // Profile name -> profile
+  std::unordered_map<std::string, DbColumnProfile> profiles;
+  // Column name -> profile name, columns without profile use default rocksdb column options
+  std::unordered_map<std::string, std::string> columns;
+  // Collect rocksdb statistics and per column cache hits/misses, enabled by node when metrics are exported
+  bool statistics = false;
+};
+
+void dec_json(Json::Value const &json, RocksDbConfig &rocksdb_config);
+
 struct DBConfig {
   uint32_t db_snapshot_each_n_pbft_block = 0;
   uint32_t db_max_snapshots = 0;
+  // Directory snapshots are incrementally backed up to, empty disables backup
+  std::string db_snapshots_backup_path;
+  // IO rate limit of snapshots backup in MB/s, 0 means unlimited
+  uint32_t db_snapshots_backup_rate_limit_mb = 0;
+  // IO rate limit of background history pruning in MB/s, 0 means unlimited
+  uint32_t db_prune_rate_limit_mb = 0;
   uint32_t db_max_open_files = 0;
   PbftPeriod db_revert_to_period = 0;
   bool rebuild_db = false;
   bool prune_state_db = false;
   bool migrate_only = false;
   bool fix_trx_period = false;
+  // Maintain address/first topic -> block number index used by log filters
+  bool log_index = false;
+  bool rebuild_log_index = false;
+  // Store receipts of each block as single blob instead of receipt per transaction hash
+  bool receipts_by_block = false;
   PbftPeriod rebuild_db_period = 0;
+  RocksDbConfig rocksdb;
 };
 
 void dec_json(Json::Value const &json, DBConfig &db_config);
@@ -58,11 +102,20 @@ struct FullNodeConfig {
   bool enable_test_rpc = false;
   bool enable_debug = false;
   uint32_t final_chain_cache_in_blocks = 5;
+  uint32_t final_chain_prefetch_threads = 0;  // Threads reading state of finalized block accounts, 0 to disable
   uint64_t propose_dag_gas_limit = 0x1E0A6E0;
   uint64_t propose_pbft_gas_limit = 0x12C684C0;
 
   // config values that limits transactions pool
   uint32_t transactions_pool_size = kDefaultTransactionPoolSize;
+  // Threads recovering senders of received transactions batches, 0 to recover on the receiving thread
+  uint32_t transactions_sender_recovery_threads = 4;
+  // Threads estimating gas of dag block transactions, 0 to estimate on the calling thread
+  uint32_t transactions_gas_estimation_threads = 4;
+  // Journal transactions pool in db in background and restore it on restart
+  bool transactions_pool_journal = false;
+  // Threads verifying dag blocks of synced batches, 0 to verify on the receiving thread
+  uint32_t dag_verification_threads = 4;
 
   // Report malicious behaviour like double voting, etc... to slashing/jailing contract
   bool report_malicious_behaviour = false;
@@ -2,6 +2,7 @@
 
 #include <json/json.h>
 
+#include <algorithm>
 #include <fstream>
 
 #include "common/config_exception.hpp"
@@ -10,12 +11,59 @@
 
 namespace taraxa {
 
+void dec_json(Json::Value const &json, DbColumnProfile &profile) {
+  profile.bloom_bits_per_key = getConfigDataAsUInt(json, {"bloom_bits_per_key"}, true, profile.bloom_bits_per_key);
+  profile.block_size_kb = getConfigDataAsUInt(json, {"block_size_kb"}, true, profile.block_size_kb);
+  profile.block_cache_mb = getConfigDataAsUInt(json, {"block_cache_mb"}, true, profile.block_cache_mb);
+  profile.prefix_length = getConfigDataAsUInt(json, {"prefix_length"}, true, profile.prefix_length);
+  for (const auto &compression : json["compression_per_level"]) {
+    const auto &name = profile.compression_per_level.emplace_back(compression.asString());
+    if (std::find(RocksDbConfig::kSupportedCompressions.begin(), RocksDbConfig::kSupportedCompressions.end(), name) ==
+        RocksDbConfig::kSupportedCompressions.end()) {
+      throw ConfigException("Unsupported db compression type: " + name);
+    }
+  }
+}
+
+void dec_json(Json::Value const &json, RocksDbConfig &rocksdb_config) {
+  if (json.isNull()) {
+    return;
+  }
+
+  rocksdb_config.block_cache_mb = getConfigDataAsUInt(json, {"block_cache_mb"}, true, rocksdb_config.block_cache_mb);
+  rocksdb_config.row_cache_mb = getConfigDataAsUInt(json, {"row_cache_mb"}, true, rocksdb_config.row_cache_mb);
+
+  const auto &profiles = json["profiles"];
+  for (auto it = profiles.begin(); it != profiles.end(); ++it) {
+    dec_json(*it, rocksdb_config.profiles[it.name()]);
+  }
+
+  const auto &columns = json["columns"];
+  for (auto it = columns.begin(); it != columns.end(); ++it) {
+    const auto profile = it->asString();
+    if (!rocksdb_config.profiles.contains(profile)) {
+      throw ConfigException("Db column " + it.name() + " uses undefined profile " + profile);
+    }
+    rocksdb_config.columns[it.name()] = profile;
+  }
+}
+
 void dec_json(Json::Value const &json, DBConfig &db_config) {
   db_config.db_snapshot_each_n_pbft_block =
       getConfigDataAsUInt(json, {"db_snapshot_each_n_pbft_block"}, true, db_config.db_snapshot_each_n_pbft_block);
 
   db_config.db_max_snapshots = getConfigDataAsUInt(json, {"db_max_snapshots"}, true, db_config.db_max_snapshots);
+  db_config.db_snapshots_backup_path =
+      getConfigDataAsString(json, {"db_snapshots_backup_path"}, true, db_config.db_snapshots_backup_path);
+  db_config.db_snapshots_backup_rate_limit_mb = getConfigDataAsUInt(json, {"db_snapshots_backup_rate_limit_mb"}, true,
+                                                                    db_config.db_snapshots_backup_rate_limit_mb);
+  db_config.db_prune_rate_limit_mb =
+      getConfigDataAsUInt(json, {"db_prune_rate_limit_mb"}, true, db_config.db_prune_rate_limit_mb);
   db_config.db_max_open_files = getConfigDataAsUInt(json, {"db_max_open_files"}, true, db_config.db_max_open_files);
+  db_config.log_index = getConfigDataAsBoolean(json, {"log_index"}, true, db_config.log_index);
+  db_config.receipts_by_block =
+      getConfigDataAsBoolean(json, {"receipts_by_block"}, true, db_config.receipts_by_block);
+  dec_json(json["rocksdb"], db_config.rocksdb);
 }
 
 std::vector<logger::Config> FullNodeConfig::loadLoggingConfigs(const Json::Value &logging) {
@@ -73,9 +121,19 @@ void FullNodeConfig::overwriteConfigFromJson(const Json::Value &root) {
 
   final_chain_cache_in_blocks =
       getConfigDataAsUInt(root, {"final_chain_cache_in_blocks"}, true, final_chain_cache_in_blocks);
+  final_chain_prefetch_threads =
+      getConfigDataAsUInt(root, {"final_chain_prefetch_threads"}, true, final_chain_prefetch_threads);
 
   // config values that limits transactions and blocks memory pools
   transactions_pool_size = getConfigDataAsUInt(root, {"transactions_pool_size"}, true, kDefaultTransactionPoolSize);
+  transactions_sender_recovery_threads = getConfigDataAsUInt(root, {"transactions_sender_recovery_threads"}, true,
+                                                             transactions_sender_recovery_threads);
+  transactions_gas_estimation_threads = getConfigDataAsUInt(root, {"transactions_gas_estimation_threads"}, true,
+                                                            transactions_gas_estimation_threads);
+  transactions_pool_journal =
+      getConfigDataAsBoolean(root, {"transactions_pool_journal"}, true, transactions_pool_journal);
+  dag_verification_threads =
+      getConfigDataAsUInt(root, {"dag_verification_threads"}, true, dag_verification_threads);
 
   dec_json(root["network"], network);
 
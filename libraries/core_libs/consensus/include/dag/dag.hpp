@@ -1,17 +1,14 @@
 #pragma once
 
 #include <boost/function.hpp>
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/breadth_first_search.hpp>
-#include <boost/graph/depth_first_search.hpp>
-#include <boost/graph/graph_traits.hpp>
-#include <boost/graph/graphviz.hpp>
-#include <boost/graph/labeled_graph.hpp>
-#include <boost/graph/properties.hpp>
-#include <boost/property_map/property_map.hpp>
 #include <boost/thread.hpp>
 #include <iostream>
+#include <limits>
+#include <map>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "common/types.hpp"
 #include "logger/logger.hpp"
@@ -26,33 +23,15 @@ class Network;
 
 /**
  * @brief Thread safe. Labelled graph.
+ *
+ * Vertices get dense ids in insertion order, hashes and adjacency lists are stored in vectors indexed by vertex id and
+ * hash -> id index is used only to find vertices by label. Graph only grows, it is rebuilt with clear() from the anchor
+ * on every finalized period, so vertices are never removed one by one.
  */
 class Dag {
  public:
-  // properties
-  using vertex_property_t =
-      boost::property<boost::vertex_index_t, blk_hash_t, boost::property<boost::vertex_index1_t, uint64_t>>;
-  using edge_property_t = boost::property<boost::edge_index_t, uint64_t>;
-
-  // graph def
-  using adj_list_t =
-      boost::adjacency_list<boost::setS, boost::hash_setS, boost::directedS, vertex_property_t, edge_property_t>;
-  using graph_t = boost::labeled_graph<adj_list_t, blk_hash_t, boost::hash_mapS>;
-  using vertex_t = boost::graph_traits<graph_t>::vertex_descriptor;
-  using edge_t = boost::graph_traits<graph_t>::edge_descriptor;
-  using vertex_iter_t = boost::graph_traits<graph_t>::vertex_iterator;
-  using edge_iter_t = boost::graph_traits<graph_t>::edge_iterator;
-  using vertex_adj_iter_t = boost::graph_traits<graph_t>::adjacency_iterator;
-
-  // property_map
-  using vertex_index_map_const_t = boost::property_map<graph_t, boost::vertex_index_t>::const_type;
-  using vertex_index_map_t = boost::property_map<graph_t, boost::vertex_index_t>::type;
-
-  using vertex_period_map_const_t = boost::property_map<graph_t, boost::vertex_index1_t>::const_type;
-  using vertex_period_map_t = boost::property_map<graph_t, boost::vertex_index1_t>::type;
-
-  using edge_index_map_const_t = boost::property_map<graph_t, boost::edge_index_t>::const_type;
-  using edge_index_map_t = boost::property_map<graph_t, boost::edge_index_t>::type;
+  using vertex_t = uint32_t;
+  static constexpr vertex_t kNullVertex = std::numeric_limits<vertex_t>::max();
 
   friend DagManager;
 
@@ -75,17 +54,25 @@ class Dag {
   bool computeOrder(const blk_hash_t &anchor, std::vector<blk_hash_t> &ordered_period_vertices,
                     const std::map<uint64_t, std::unordered_set<blk_hash_t>> &non_finalized_blks);
 
-  void clear();
+  virtual void clear();
 
  protected:
   // Note: private functions does not lock
 
-  // traverser API
-  bool reachable(vertex_t const &from, vertex_t const &to) const;
+  vertex_t vertex(blk_hash_t const &hash) const;
+  vertex_t addVertex(blk_hash_t const &hash);
+  virtual bool addEdge(vertex_t from, vertex_t to);
 
   void collectLeafVertices(std::vector<vertex_t> &leaves) const;
 
-  graph_t graph_;
+  // Vertex id -> block hash
+  std::vector<blk_hash_t> vertices_;
+  // Vertex id -> ids of vertices that edges from it point to, edges point from pivot/tip to the new block
+  std::vector<std::vector<vertex_t>> children_;
+  // Vertex id -> ids of vertices with edges pointing to it
+  std::vector<std::vector<vertex_t>> parents_;
+  std::unordered_map<blk_hash_t, vertex_t> vertex_ids_;
+  uint64_t edges_count_ = 0;
 
  protected:
   LOG_OBJECTS_DEFINE
@@ -108,47 +95,38 @@ class PivotTree : public Dag {
   PivotTree &operator=(const PivotTree &) = default;
   PivotTree &operator=(PivotTree &&) = default;
 
-  using Dag::vertex_adj_iter_t;
-  using Dag::vertex_index_map_const_t;
   using Dag::vertex_t;
 
+  /**
+   * @brief Gets ghost path from vertex, following the heaviest subtree on each step. Subtree weights are maintained
+   * when edges are added, so query only walks the path itself
+   */
   std::vector<blk_hash_t> getGhostPath(const blk_hash_t &vertex) const;
+
+  void clear() override;
+
+  /**
+   * @brief Stops updating subtree weights on added edges until rebuildWeights is called. Each update walks up to the
+   * root, so bulk insertion of many blocks is cheaper with single rebuild at the end
+   */
+  void deferWeights();
+
+  /**
+   * @brief Computes all subtree weights in one pass from leaves and resumes updating them on added edges
+   */
+  void rebuildWeights();
+
+ protected:
+  bool addEdge(vertex_t from, vertex_t to) override;
+
+  // Vertex id -> number of vertices in its subtree including itself
+  std::vector<size_t> weights_;
+  bool weights_deferred_ = false;
 };
 class DagBuffer;
 class FullNode;
 class KeyManager;
 
-// for graphviz
-template <class Property1>
-class vertex_label_writer {
- public:
-  vertex_label_writer(Property1 name) : name(name) {}
-  template <class Vertex>
-  void operator()(std::ostream &out, const Vertex &v) const {
-    out << "[label=\"" << name[v].toString().substr(0, 8) << " "
-        << "\"]";
-  }
-
- private:
-  Property1 name;
-};
-
-template <class Property>
-class edge_label_writer {
- public:
-  explicit edge_label_writer(Property weight) : weight(weight) {}
-  template <class Edge>
-  void operator()(std::ostream &out, const Edge &e) const {
-    if (weight[e] == 0) {
-      out << "[style=\"dashed\" dir=\"back\"]";
-    } else {
-      out << "[dir=\"back\"]";
-    }
-  }
-
- private:
-  Property weight;
-};
 /** @}*/
 
 }  // namespace taraxa
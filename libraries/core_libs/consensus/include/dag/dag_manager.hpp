@@ -1,5 +1,7 @@
 #pragma once
 
+#include <boost/asio/thread_pool.hpp>
+
 #include "dag.hpp"
 #include "dag/dag_block.hpp"
 #include "pbft/pbft_chain.hpp"
@@ -72,6 +74,13 @@ class DagManager : public std::enable_shared_from_this<DagManager> {
    */
   std::shared_ptr<DagBlock> getDagBlock(const blk_hash_t &hash) const;
 
+  /**
+   * @brief Gets dag blocks from either local memory cache or db, blocks missing in the cache are read in one batch
+   * @param hashes Block hashes
+   * @return Blocks in the order of provided hashes, nullptr for blocks not found
+   */
+  std::vector<std::shared_ptr<DagBlock>> getDagBlocks(const std::vector<blk_hash_t> &hashes) const;
+
   /**
    * @brief Verifies new DAG block
    * @param blk Block to verify
@@ -82,6 +91,18 @@ class DagManager : public std::enable_shared_from_this<DagManager> {
       const std::shared_ptr<DagBlock> &blk,
       const std::unordered_map<trx_hash_t, std::shared_ptr<Transaction>> &trxs = {});
 
+  /**
+   * @brief Verifies batch of new DAG blocks in parallel, VDF solutions of the batch are verified together with
+   * VdfSortition::verifyVdfs. Blocks are verified independently of each other so block with tip in the same batch can
+   * fail with MissingTip and should be verified again after its tips are added
+   * @param blks Blocks to verify
+   * @param trxs Optional blocks transactions
+   * @return verification results in the order of blocks
+   */
+  std::vector<std::pair<VerifyBlockReturnType, SharedTransactions>> verifyBlocks(
+      const std::vector<std::shared_ptr<DagBlock>> &blks,
+      const std::unordered_map<trx_hash_t, std::shared_ptr<Transaction>> &trxs = {});
+
   /**
    * @brief Checks if block pivot and tips are in DAG
    * @param blk Block to check
@@ -238,9 +259,28 @@ class DagManager : public std::enable_shared_from_this<DagManager> {
   void clearLightNodeHistory(uint64_t light_node_history);
 
  private:
+  // Block verification state between its steps, VDF solutions of all verified blocks are checked in one batch in between
+  struct BlockVerification {
+    VerifyBlockReturnType result = VerifyBlockReturnType::Verified;
+    SharedTransactions trxs;
+    PbftPeriod propose_period = 0;
+    std::optional<vdf_sortition::VdfVerification> vdf;
+  };
+  // Checks done before VDF verification, result is Verified if block passed them
+  BlockVerification prepareBlockVerification(const std::shared_ptr<DagBlock> &blk,
+                                             const std::unordered_map<trx_hash_t, std::shared_ptr<Transaction>> &trxs);
+  // Verifies VDF solutions of blocks that passed preparation, results of invalid ones are set to FailedVdfVerification
+  void verifyBlocksVdf(const std::vector<std::shared_ptr<DagBlock>> &blks,
+                       std::vector<BlockVerification> &verifications);
+  // Checks done after VDF verification
+  std::pair<VerifyBlockReturnType, SharedTransactions> finishBlockVerification(const std::shared_ptr<DagBlock> &blk,
+                                                                               BlockVerification &&verification);
+
   void recoverDag();
   void addToDag(blk_hash_t const &hash, blk_hash_t const &pivot, std::vector<blk_hash_t> const &tips, uint64_t level,
                 bool finalized = false);
+  // Inserts block to the in memory DAG, mutex_ must be locked
+  void insertDagBlock(const std::shared_ptr<DagBlock> &blk);
   bool validateBlockNotExpired(const std::shared_ptr<DagBlock> &dag_block,
                                std::unordered_map<blk_hash_t, std::shared_ptr<DagBlock>> &expired_dag_blocks_to_remove);
   void handleExpiredDagBlocksTransactions(const std::vector<trx_hash_t> &transactions_from_expired_dag_blocks) const;
@@ -282,6 +322,9 @@ class DagManager : public std::enable_shared_from_this<DagManager> {
   const GenesisConfig kGenesis;
   const uint64_t kValidatorMaxVote;
 
+  const uint32_t kVerificationThreads;
+  std::unique_ptr<boost::asio::thread_pool> verification_pool_;
+
   LOG_OBJECTS_DEFINE
 };
 
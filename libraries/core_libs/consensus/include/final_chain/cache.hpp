@@ -1,8 +1,13 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <functional>
+#include <future>
 #include <map>
 #include <mutex>
+#include <optional>
+#include <set>
 #include <shared_mutex>
 #include <unordered_map>
 #include <vector>
@@ -26,145 +31,352 @@ struct is_empty<std::vector<T>> {
 };
 }  // namespace
 
+struct CacheStats {
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  // Requests that waited for the same value being got by another thread
+  uint64_t coalesced = 0;
+  uint64_t evictions = 0;
+};
+
+/**
+ * @brief Cache of values by block number and key that keeps values of last kBlocksToKeep blocks.
+ *
+ * Window is counted by block numbers, so it holds blocks from lastBlockNum() - kBlocksToKeep + 1 up to lastBlockNum().
+ * Values are spread over shards by block number and key, so readers of different keys don't contend on the same lock.
+ * Values of blocks that went out of the window are invisible right away and are erased from a shard on next access to
+ * it, so neither writers nor readers lock more than one shard.
+ * Concurrent requests of the same missing value are coalesced, so getter is called only once per missing value.
+ */
 template <class Key, class Value>
-class MapByBlockCache {
+class ShardedByBlockCache {
  public:
-  using GetterFn = std::function<Value(uint64_t, const Key &)>;
-  using ValueMap = std::unordered_map<Key, Value>;
-  using DataMap = std::map<uint64_t, ValueMap>;
+  ShardedByBlockCache(const ShardedByBlockCache &) = delete;
+  ShardedByBlockCache(ShardedByBlockCache &&) = delete;
+  ShardedByBlockCache &operator=(const ShardedByBlockCache &) = delete;
+  ShardedByBlockCache &operator=(ShardedByBlockCache &&) = delete;
 
-  MapByBlockCache(const MapByBlockCache &) = delete;
-  MapByBlockCache(MapByBlockCache &&) = delete;
-  MapByBlockCache &operator=(const MapByBlockCache &) = delete;
-  MapByBlockCache &operator=(MapByBlockCache &&) = delete;
+  uint64_t lastBlockNum() const { return last_block_num_.load(std::memory_order_acquire); }
 
-  MapByBlockCache(uint64_t blocks_to_save, GetterFn &&getter_fn)
-      : kBlocksToKeep(blocks_to_save), getter_fn_(std::move(getter_fn)) {}
+  CacheStats stats() const {
+    CacheStats ret;
+    for (const auto &shard : shards_) {
+      ret.hits += shard.hits.load(std::memory_order_relaxed);
+      ret.misses += shard.misses.load(std::memory_order_relaxed);
+      ret.coalesced += shard.coalesced.load(std::memory_order_relaxed);
+      ret.evictions += shard.evictions.load(std::memory_order_relaxed);
+    }
+    return ret;
+  }
 
-  void append(uint64_t block_num, const Key &key, const Value &value) const {
-    std::unique_lock lock(mutex_);
+ protected:
+  static constexpr size_t kShardsCount = 16;
+  using StoredValue = std::remove_const_t<Value>;
 
-    auto blk_entry = data_by_block_.find(block_num);
-    if (blk_entry == data_by_block_.end()) {
-      blk_entry = data_by_block_.emplace(block_num, ValueMap()).first;
+  struct KeyHash {
+    size_t operator()(const Key &key) const { return std::hash<Key>{}(key); }
+  };
+  using ValueMap = std::unordered_map<Key, Value, KeyHash>;
+
+  struct alignas(64) Shard {
+    mutable std::shared_mutex mutex;
+    std::map<uint64_t, ValueMap> data_by_block;
+    std::map<std::pair<uint64_t, Key>, std::shared_future<StoredValue>> in_flight;
+    std::atomic<uint64_t> hits = 0;
+    std::atomic<uint64_t> misses = 0;
+    std::atomic<uint64_t> coalesced = 0;
+    std::atomic<uint64_t> evictions = 0;
+
+    const Value *find(uint64_t blk_num, const Key &key, uint64_t first_blk_num) const {
+      if (blk_num < first_blk_num) {
+        return nullptr;
+      }
+      auto blk_entry = data_by_block.find(blk_num);
+      if (blk_entry == data_by_block.end()) {
+        return nullptr;
+      }
+      auto e = blk_entry->second.find(key);
+      return e == blk_entry->second.end() ? nullptr : &e->second;
     }
-    blk_entry->second.emplace(key, value);
 
-    // Remove older element after we added one more
-    if (data_by_block_.size() > kBlocksToKeep) {
-      data_by_block_.erase(data_by_block_.begin());
+    // Should be called under lock
+    bool hasBlocksBefore(uint64_t first_blk_num) const {
+      return !data_by_block.empty() && data_by_block.begin()->first < first_blk_num;
     }
+
+    // Should be called under unique lock
+    void evictBefore(uint64_t first_blk_num) {
+      while (hasBlocksBefore(first_blk_num)) {
+        evictions.fetch_add(data_by_block.begin()->second.size(), std::memory_order_relaxed);
+        data_by_block.erase(data_by_block.begin());
+      }
+    }
+  };
+
+  explicit ShardedByBlockCache(uint64_t blocks_to_save) : kBlocksToKeep(blocks_to_save) {}
+
+  Shard &shard(uint64_t blk_num, const Key &key) const {
+    return shards_[(KeyHash{}(key) ^ (blk_num * 0x9E3779B97F4A7C15ULL)) % kShardsCount];
   }
 
-  Value get(uint64_t blk_num, const Key &key) const {
+  // First block number that is still in the window of kBlocksToKeep last blocks
+  uint64_t firstBlockNum() const {
+    const auto last_num = lastBlockNum();
+    return last_num < kBlocksToKeep ? 0 : last_num - kBlocksToKeep + 1;
+  }
+
+  // Looks value up under shared lock and counts a hit if it is found. Old blocks are erased after that, so shards that
+  // stopped getting writes are cleaned up too. Readers don't wait for it, eviction is skipped if shard is busy
+  std::optional<StoredValue> findCached(Shard &s, uint64_t blk_num, const Key &key) const {
+    std::optional<StoredValue> ret;
+    bool has_old_blocks = false;
     {
-      std::shared_lock lock(mutex_);
-      auto blk_entry = data_by_block_.find(blk_num);
-      if (blk_entry != data_by_block_.end()) {
-        auto e = blk_entry->second.find(key);
-        if (e != blk_entry->second.end()) {
-          return e->second;
-        }
+      std::shared_lock lock(s.mutex);
+      const auto first_num = firstBlockNum();
+      if (const auto *value = s.find(blk_num, key, first_num)) {
+        s.hits.fetch_add(1, std::memory_order_relaxed);
+        ret.emplace(*value);
       }
+      has_old_blocks = s.hasBlocksBefore(first_num);
     }
+    if (has_old_blocks) {
+      std::unique_lock lock(s.mutex, std::try_to_lock);
+      if (lock.owns_lock()) {
+        s.evictBefore(firstBlockNum());
+      }
+    }
+    return ret;
+  }
 
-    auto value = getter_fn_(blk_num, key);
-    if (is_empty(value)) {
-      return {};
+  void appendImpl(uint64_t blk_num, const Key &key, const Value &value) const {
+    // Move the window forward without lock, concurrent writers can't move it back
+    auto last_num = last_block_num_.load(std::memory_order_acquire);
+    while (last_num < blk_num && !last_block_num_.compare_exchange_weak(last_num, blk_num, std::memory_order_acq_rel)) {
     }
-    // Not save old values in cache
-    auto last_num = lastBlockNum();
-    if (last_num < kBlocksToKeep || blk_num >= last_num - kBlocksToKeep) {
-      append(blk_num, key, value);
+    has_blocks_.store(true, std::memory_order_release);
+
+    const auto first_num = firstBlockNum();
+    if (blk_num < first_num) {
+      return;
+    }
+    auto &s = shard(blk_num, key);
+    std::unique_lock lock(s.mutex);
+    s.evictBefore(first_num);
+    s.data_by_block[blk_num].emplace(key, value);
+  }
+
+  template <class GetterFn>
+  StoredValue getImpl(uint64_t blk_num, const Key &key, const GetterFn &getter) const {
+    auto &s = shard(blk_num, key);
+    if (auto value = findCached(s, blk_num, key)) {
+      return std::move(*value);
+    }
+
+    std::promise<StoredValue> promise;
+    std::shared_future<StoredValue> in_flight;
+    {
+      std::unique_lock lock(s.mutex);
+      const auto first_num = firstBlockNum();
+      s.evictBefore(first_num);
+      if (const auto *value = s.find(blk_num, key, first_num)) {
+        s.hits.fetch_add(1, std::memory_order_relaxed);
+        return *value;
+      }
+      auto [it, inserted] = s.in_flight.try_emplace({blk_num, key});
+      if (inserted) {
+        it->second = promise.get_future().share();
+      } else {
+        in_flight = it->second;
+      }
+    }
+    // Someone is already getting this value, wait for the result instead of calling getter again
+    if (in_flight.valid()) {
+      s.coalesced.fetch_add(1, std::memory_order_relaxed);
+      return in_flight.get();
+    }
+    s.misses.fetch_add(1, std::memory_order_relaxed);
+
+    const auto finish_in_flight = [&] {
+      std::unique_lock lock(s.mutex);
+      s.in_flight.erase({blk_num, key});
+    };
+    try {
+      StoredValue value = getter();
+      appendIfRecent(blk_num, key, value);
+      finish_in_flight();
+      promise.set_value(value);
+      return value;
+    } catch (...) {
+      finish_in_flight();
+      promise.set_exception(std::current_exception());
+      throw;
+    }
+  }
+
+  std::optional<StoredValue> findImpl(uint64_t blk_num, const Key &key) const {
+    auto &s = shard(blk_num, key);
+    auto value = findCached(s, blk_num, key);
+    if (!value) {
+      s.misses.fetch_add(1, std::memory_order_relaxed);
     }
     return value;
   }
 
-  uint64_t lastBlockNum() const {
-    std::shared_lock lock(mutex_);
-    if (data_by_block_.empty()) {
-      return 0;
+  void appendIfRecent(uint64_t blk_num, const Key &key, const Value &value) const {
+    // Not save empty and old values in cache
+    if (!is_empty(value) && blk_num >= firstBlockNum()) {
+      appendImpl(blk_num, key, value);
     }
-    return data_by_block_.rbegin()->first;
   }
 
- protected:
+  std::optional<StoredValue> lastImpl(const Key &key) const {
+    if (!has_blocks_.load(std::memory_order_acquire)) {
+      return {};
+    }
+    const auto blk_num = lastBlockNum();
+    return findCached(shard(blk_num, key), blk_num, key);
+  }
+
+  // Blocks in the window that have values, walks all shards so is used only in tests
+  std::set<uint64_t> cachedBlocks() const {
+    std::set<uint64_t> ret;
+    for (const auto &s : shards_) {
+      std::shared_lock lock(s.mutex);
+      for (auto blk_entry = s.data_by_block.lower_bound(firstBlockNum()); blk_entry != s.data_by_block.end();
+           ++blk_entry) {
+        ret.insert(blk_entry->first);
+      }
+    }
+    return ret;
+  }
+
+  uint64_t blocksCount() const { return cachedBlocks().size(); }
+
+  bool containsBlock(uint64_t blk_num) const { return cachedBlocks().contains(blk_num); }
+
+  bool containsValue(uint64_t blk_num, const Key &key) const {
+    const auto &s = shard(blk_num, key);
+    std::shared_lock lock(s.mutex);
+    return s.find(blk_num, key, firstBlockNum()) != nullptr;
+  }
+
   const uint64_t kBlocksToKeep;
-  GetterFn getter_fn_;
 
   // cache is used from const methods in other class, so should be mutable
-  mutable std::shared_mutex mutex_;
-  mutable DataMap data_by_block_;
+  mutable std::array<Shard, kShardsCount> shards_;
+  mutable std::atomic<uint64_t> last_block_num_ = 0;
+  mutable std::atomic<bool> has_blocks_ = false;
 };
 
-template <class Value>
-class ValueByBlockCache {
+template <class Key, class Value>
+class MapByBlockCache : public ShardedByBlockCache<Key, Value> {
+  using Base = ShardedByBlockCache<Key, Value>;
+
  public:
-  using GetterFn = std::function<Value(uint64_t)>;
-  using DataMap = std::map<uint64_t, Value>;
+  using GetterFn = std::function<Value(uint64_t, const Key &)>;
 
-  ValueByBlockCache(const ValueByBlockCache &) = delete;
-  ValueByBlockCache(ValueByBlockCache &&) = delete;
-  ValueByBlockCache &operator=(const ValueByBlockCache &) = delete;
-  ValueByBlockCache &operator=(ValueByBlockCache &&) = delete;
+  MapByBlockCache(uint64_t blocks_to_save, GetterFn &&getter_fn)
+      : Base(blocks_to_save), getter_fn_(std::move(getter_fn)) {}
 
-  ValueByBlockCache(uint64_t blocks_to_save, GetterFn &&getter_fn)
-      : kBlocksToKeep(blocks_to_save), getter_fn_(std::move(getter_fn)) {}
+  /**
+   * @brief Creates cache without default getter, values are got only with getter passed to get
+   */
+  explicit MapByBlockCache(uint64_t blocks_to_save) : Base(blocks_to_save) {}
 
-  void append(uint64_t block_num, Value value) const {
-    std::unique_lock lock(mutex_);
-    data_by_block_.emplace(block_num, value);
+  void append(uint64_t block_num, const Key &key, const Value &value) const { Base::appendImpl(block_num, key, value); }
 
-    // Remove older element after we added one more
-    if (data_by_block_.size() > kBlocksToKeep) {
-      data_by_block_.erase(data_by_block_.begin());
-    }
+  Value get(uint64_t blk_num, const Key &key) const {
+    return Base::getImpl(blk_num, key, [&] { return getter_fn_(blk_num, key); });
   }
 
-  Value get(uint64_t block_num) const {
-    {
-      std::shared_lock lock(mutex_);
-      auto blk_entry = data_by_block_.find(block_num);
-      if (blk_entry != data_by_block_.end()) {
-        return blk_entry->second;
+  /**
+   * @brief Gets value with passed getter, for values that need more than block number and key to be computed
+   */
+  template <class Fn>
+  Value get(uint64_t blk_num, const Key &key, const Fn &getter) const {
+    return Base::getImpl(blk_num, key, getter);
+  }
+
+  /**
+   * @brief Gets values of many keys at one block, values missing in cache are got with single batch_getter call
+   * @param batch_getter returns values of passed keys in the same order
+   */
+  template <class BatchGetterFn>
+  std::vector<typename Base::StoredValue> getMany(uint64_t blk_num, const std::vector<Key> &keys,
+                                                  const BatchGetterFn &batch_getter) const {
+    // Values could be not assignable(e.g. optional of const), so they are constructed in place
+    std::vector<std::optional<typename Base::StoredValue>> values(keys.size());
+    std::vector<Key> missing_keys;
+    std::vector<size_t> missing_pos;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (auto value = Base::findImpl(blk_num, keys[i])) {
+        values[i].emplace(std::move(*value));
+      } else {
+        missing_keys.push_back(keys[i]);
+        missing_pos.push_back(i);
       }
     }
-
-    auto value = getter_fn_(block_num);
-    if (is_empty(value)) {
-      return {};
+    if (!missing_keys.empty()) {
+      auto missing_values = batch_getter(blk_num, missing_keys);
+      for (size_t i = 0; i < missing_keys.size(); ++i) {
+        Base::appendIfRecent(blk_num, missing_keys[i], missing_values[i]);
+        values[missing_pos[i]].emplace(std::move(missing_values[i]));
+      }
     }
-    // Not save old values in cache
-    auto last_num = lastBlockNum();
-    if (last_num < kBlocksToKeep || block_num >= last_num - kBlocksToKeep) {
-      append(block_num, value);
+
+    std::vector<typename Base::StoredValue> ret;
+    ret.reserve(values.size());
+    for (auto &value : values) {
+      ret.emplace_back(std::move(*value));
     }
-    return value;
+    return ret;
   }
 
-  Value last() const {
-    std::shared_lock lock(mutex_);
-    if (data_by_block_.empty()) {
-      return {};
-    }
-    return data_by_block_.rbegin()->second;
+ protected:
+  GetterFn getter_fn_;
+};
+
+namespace detail {
+// Key of values cached only by block number
+struct NoKey {
+  auto operator<=>(const NoKey &) const = default;
+};
+}  // namespace detail
+
+}  // namespace taraxa
+
+template <>
+struct std::hash<taraxa::detail::NoKey> {
+  size_t operator()(const taraxa::detail::NoKey &) const { return 0; }
+};
+
+namespace taraxa {
+
+template <class Value>
+class ValueByBlockCache : public ShardedByBlockCache<detail::NoKey, Value> {
+  using Base = ShardedByBlockCache<detail::NoKey, Value>;
+
+ public:
+  using GetterFn = std::function<Value(uint64_t)>;
+
+  ValueByBlockCache(uint64_t blocks_to_save, GetterFn &&getter_fn)
+      : Base(blocks_to_save), getter_fn_(std::move(getter_fn)) {}
+
+  void append(uint64_t block_num, Value value) const { Base::appendImpl(block_num, {}, value); }
+
+  Value get(uint64_t block_num) const {
+    return Base::getImpl(block_num, {}, [&] { return getter_fn_(block_num); });
   }
 
-  uint64_t lastBlockNum() const {
-    std::shared_lock lock(mutex_);
-    if (data_by_block_.empty()) {
-      return 0;
+  Value last() const {
+    if (auto value = Base::lastImpl({})) {
+      return std::move(*value);
     }
-    return data_by_block_.rbegin()->first;
+    return {};
   }
 
  protected:
-  const uint64_t kBlocksToKeep;
   GetterFn getter_fn_;
-
-  // cache is used from const methods in other class, so should be mutable
-  mutable std::shared_mutex mutex_;
-  mutable DataMap data_by_block_;
 };
 
-}  // namespace taraxa
\ No newline at end of file
+}  // namespace taraxa
@@ -73,6 +73,29 @@ static constexpr auto c_bloomIndexLevels = 2;
 
 using BlocksBlooms = std::array<LogBloom, c_bloomIndexSize>;
 
+/**
+ * @brief Makes id of bloom index chunk. Chunk with index i on level l has blooms of c_bloomIndexSize sub-ranges of
+ * c_bloomIndexSize^l blocks, starting from block i * c_bloomIndexSize^(l + 1)
+ */
+h256 blockBloomsChunkId(EthBlockNumber level, EthBlockNumber index);
+
+// Log index key kinds. Key of block kind lists address and topic keys of the block, so they are pruned with it
+static constexpr uint8_t kLogIndexAddress = 0;
+static constexpr uint8_t kLogIndexTopic = 1;
+static constexpr uint8_t kLogIndexBlock = 2;
+
+/**
+ * @brief Makes log index key: kind + address/topic + big endian block number, so keys of the same address/topic are
+ * ordered by block number
+ */
+dev::bytes logIndexKey(uint8_t kind, dev::bytesConstRef id, EthBlockNumber blk_n);
+
+/**
+ * @brief Checks that all bits of part are set in bloom. Works on 64-bit words without temporaries, so the loop gets
+ * vectorized by compiler
+ */
+bool bloomContains(const LogBloom& bloom, const LogBloom& part);
+
 struct LogEntry {
   Address address;
   h256s topics;
@@ -99,6 +122,14 @@ struct TransactionReceipt {
 
 using TransactionReceipts = std::vector<TransactionReceipt>;
 
+/**
+ * @brief Receipts of a block stored as a single value: receipts count, table of receipts end offsets and concatenated
+ * receipts RLPs. Single receipt is decoded from the blob without decoding the other receipts
+ */
+bytes encodeReceiptsBlob(const std::vector<bytes>& receipts_rlp);
+TransactionReceipts decodeReceiptsBlob(bytesConstRef blob);
+std::optional<TransactionReceipt> decodeReceiptFromBlob(bytesConstRef blob, size_t index);
+
 struct TransactionLocation {
   EthBlockNumber period = 0;
   uint32_t position = 0;
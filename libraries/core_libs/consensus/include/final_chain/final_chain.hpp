@@ -1,6 +1,7 @@
 #pragma once
 
 #include <future>
+#include <set>
 
 #include "common/event.hpp"
 #include "common/types.hpp"
@@ -129,6 +130,21 @@ class FinalChain {
    */
   std::optional<TransactionReceipt> transactionReceipt(h256 const& _transactionHash) const;
 
+  /**
+   * @brief Method to get transaction receipts by hashes with a single batched db read
+   * @param trx_hashes hashes of transactions to get receipts for
+   * @return std::vector<std::optional<TransactionReceipt>> receipts in the order of provided hashes
+   */
+  std::vector<std::optional<TransactionReceipt>> transactionReceipts(const std::vector<h256>& trx_hashes) const;
+
+  /**
+   * @brief Method to get receipts of all block transactions, including system ones. Reads single blob if receipts are
+   * stored by block
+   * @param n block number
+   * @return TransactionReceipts receipts in the order of block transactions, empty if block is pruned
+   */
+  TransactionReceipts blockReceipts(std::optional<EthBlockNumber> n = {}) const;
+
   /**
    * @brief Method to get transactions count in block
    * @param n block number
@@ -145,6 +161,35 @@ class FinalChain {
    */
   std::vector<EthBlockNumber> withBlockBloom(LogBloom const& b, EthBlockNumber from, EthBlockNumber to) const;
 
+  /**
+   * @brief Method used to search for contract logs matching any of bloom filters. Index chunks of each level are read
+   * in batches, large ranges are split into sub-ranges searched in parallel
+   * @param blooms LogBlooms
+   * @param from EthBlockNumber block to start search
+   * @param to EthBlockNumber block to end search
+   * @return sorted blocks that match any of specified bloom filters
+   */
+  std::vector<EthBlockNumber> withBlockBloom(const LogBlooms& blooms, EthBlockNumber from, EthBlockNumber to) const;
+
+  /**
+   * @brief Method used to search for contract logs with log index
+   * @param addresses blocks with log of any of these addresses match, empty matches all
+   * @param topics blocks with log having any of these as the first topic match, empty matches all
+   * @param from EthBlockNumber block to start search
+   * @param to EthBlockNumber block to end search
+   * @return sorted blocks matching both conditions, nullopt if log index is disabled, doesn't cover the range or both
+   * conditions are empty
+   */
+  std::optional<std::vector<EthBlockNumber>> withLogIndex(const AddressSet& addresses,
+                                                          const std::unordered_set<h256>& topics, EthBlockNumber from,
+                                                          EthBlockNumber to) const;
+
+  /**
+   * @brief Method to get hit/miss/eviction stats of final chain caches
+   * @return stats of every cache with its name
+   */
+  std::vector<std::pair<std::string, CacheStats>> cachesStats() const;
+
   /**
    * @brief Method to get account information
    * @see state_api::Account
@@ -154,6 +199,15 @@ class FinalChain {
    */
   std::optional<state_api::Account> getAccount(addr_t const& addr, std::optional<EthBlockNumber> blk_n = {}) const;
 
+  /**
+   * @brief Method to get information of many accounts at once, accounts missing in cache are read with one batch
+   * @param addrs accounts addresses
+   * @param blk_n number of block we are getting state from
+   * @return account objects in order of addrs, nullopt for accounts that weren't found
+   */
+  std::vector<std::optional<state_api::Account>> getAccounts(const std::vector<addr_t>& addrs,
+                                                             std::optional<EthBlockNumber> blk_n = {}) const;
+
   /**
    * @brief Returns the value from a storage position at a given address.
    * @param addr account address
@@ -162,6 +216,16 @@ class FinalChain {
    * @return the value at this storage position
    */
   h256 getAccountStorage(addr_t const& addr, u256 const& key, std::optional<EthBlockNumber> blk_n = {}) const;
+
+  /**
+   * @brief Returns values from many storage positions at a given address.
+   * @param addr account address
+   * @param keys positions in the storage
+   * @param blk_n number of block we are getting state from
+   * @return values at these storage positions in order of keys
+   */
+  std::vector<h256> getAccountStorages(const addr_t& addr, const std::vector<u256>& keys,
+                                       std::optional<EthBlockNumber> blk_n = {}) const;
   /**
    * @brief Returns code at a given address.
    * @param addr account address
@@ -204,6 +268,14 @@ class FinalChain {
    */
   uint64_t dposEligibleVoteCount(EthBlockNumber blk_num, addr_t const& addr) const;
 
+  /**
+   * @brief total counts of eligible votes of many accounts, counts missing in cache are read with one batch
+   * @param blk_num EthBlockNumber number of block we are getting state from
+   * @param addrs accounts addresses
+   * @return eligible votes counts in order of addrs
+   */
+  std::vector<uint64_t> dposEligibleVoteCounts(EthBlockNumber blk_num, const std::vector<addr_t>& addrs) const;
+
   /**
    * @brief method to check if address have enough votes to participate in consensus
    * @param blk_num EthBlockNumber number of block we are getting state from
@@ -278,14 +350,24 @@ class FinalChain {
   std::shared_ptr<const BlockHeader> getBlockHeader(EthBlockNumber n) const;
   std::optional<h256> getBlockHash(EthBlockNumber n) const;
   EthBlockNumber lastIfAbsent(const std::optional<EthBlockNumber>& client_blk_n) const;
+  static uint32_t receiptIndex(const TransactionLocation& location);
   static state_api::EVMTransaction toEvmTransaction(const SharedTransaction& trx);
   static void appendEvmTransactions(std::vector<state_api::EVMTransaction>& evm_trxs, const SharedTransactions& trxs);
   BlocksBlooms blockBlooms(const h256& chunk_id) const;
-  static h256 blockBloomsChunkId(EthBlockNumber level, EthBlockNumber index);
-  std::vector<EthBlockNumber> withBlockBloom(const LogBloom& b, EthBlockNumber from, EthBlockNumber to,
-                                             EthBlockNumber level, EthBlockNumber index) const;
+  std::vector<EthBlockNumber> matchBlockBlooms(const LogBlooms& blooms, EthBlockNumber from, EthBlockNumber to) const;
+  void initLogIndex();
+  void rebuildLogIndex(EthBlockNumber last_block_number);
+  void addLogIndexToBatch(Batch& batch, EthBlockNumber blk_n, const TransactionReceipts& receipts);
+  void logIndexBlocks(uint8_t kind, dev::bytesConstRef id, EthBlockNumber from, EthBlockNumber to,
+                      std::set<EthBlockNumber>& blocks) const;
   bool isNeedToFinalize(EthBlockNumber blk_num) const;
 
+  /**
+   * @brief Reads accounts of block transactions senders and receivers and code of called contracts on prefetch pool,
+   * so state trie nodes are in memory when the block is executed
+   */
+  void prefetchState(const PeriodData& new_blk);
+
   SharedTransaction makeBridgeFinalizationTransaction();
   std::vector<SharedTransaction> makeSystemTransactions(PbftPeriod blk_num);
 
@@ -309,6 +391,15 @@ class FinalChain {
 
   // It is not prepared to use more then 1 thread. Examine it if you want to change threads count
   boost::asio::thread_pool executor_thread_{1};
+  // Prefetches state read by execution of queued blocks, null if prefetching is disabled
+  std::unique_ptr<boost::asio::thread_pool> prefetch_pool_;
+  const uint32_t kPrefetchThreads;
+
+  // Number of threads searching bloom index sub-ranges in parallel
+  static constexpr uint32_t kBloomQueryThreads = 4;
+  // Minimal number of top level bloom index chunks searched by single thread
+  static constexpr uint64_t kBloomQueryChunksPerThread = 64;
+  mutable boost::asio::thread_pool bloom_query_pool_{kBloomQueryThreads};
 
   std::atomic<uint64_t> num_executed_dag_blk_ = 0;
   std::atomic<uint64_t> num_executed_trx_ = 0;
@@ -329,6 +420,13 @@ class FinalChain {
   std::mutex finalized_mtx_;
 
   std::atomic<EthBlockNumber> last_block_number_;
+  // New blocks are added to log index
+  bool log_index_enabled_ = false;
+  // First block covered by log index, max if log index is disabled or not rebuilt yet
+  std::atomic<EthBlockNumber> log_index_from_ = std::numeric_limits<EthBlockNumber>::max();
+  // Rebuilds log index of blocks finalized before startup, null if rebuild is not requested
+  std::unique_ptr<boost::asio::thread_pool> log_index_rebuild_thread_;
+  std::atomic<bool> log_index_rebuild_stopped_ = false;
 
   const FullNodeConfig& kConfig;
   LOG_OBJECTS_DEFINE
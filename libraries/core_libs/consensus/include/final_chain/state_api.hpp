@@ -4,6 +4,7 @@
 
 #include <functional>
 
+#include "final_chain/data.hpp"
 #include "final_chain/state_api_data.hpp"
 #include "rewards/block_stats.hpp"
 
@@ -17,12 +18,17 @@ struct OptsDB;
  * @{
  */
 
+/**
+ * @brief Decodes execution results of block transactions, encoded as list with single list of ExecutionResult, straight
+ * into receipts without intermediate ExecutionResult objects
+ */
+void decode_receipts(bytesConstRef execution_results_rlp, final_chain::TransactionReceipts& receipts);
+
 class StateAPI {
   std::function<h256(EthBlockNumber)> get_blk_hash_;
   taraxa_evm_GetBlockHash get_blk_hash_c_;
   taraxa_evm_state_API_ptr this_c_;
   dev::RLPStream rlp_enc_execution_result_;
-  TransactionsExecutionResult result_buf_execution_result_;
   dev::RLPStream rlp_enc_rewards_distribution_;
   RewardsDistributionResult result_buf_rewards_distribution_;
   string db_path_;
@@ -40,14 +46,23 @@ class StateAPI {
 
   std::optional<Account> get_account(EthBlockNumber blk_num, const addr_t& addr) const;
   h256 get_account_storage(EthBlockNumber blk_num, const addr_t& addr, const u256& key) const;
+  // Batched reads of the same block, arguments encoding buffer and error handling are shared by all items
+  std::vector<std::optional<Account>> get_accounts(EthBlockNumber blk_num, const std::vector<addr_t>& addrs) const;
+  std::vector<h256> get_account_storages(EthBlockNumber blk_num, const addr_t& addr,
+                                         const std::vector<u256>& keys) const;
   bytes get_code_by_address(EthBlockNumber blk_num, const addr_t& addr) const;
   ExecutionResult dry_run_transaction(EthBlockNumber blk_num, const EVMBlock& blk, const EVMTransaction& trx) const;
   bytes trace(EthBlockNumber blk_num, const EVMBlock& blk, const std::vector<EVMTransaction>& state_trxs,
               const std::vector<EVMTransaction>& trxs, std::optional<Tracing> params = {}) const;
   StateDescriptor get_last_committed_state_descriptor() const;
 
-  const TransactionsExecutionResult& execute_transactions(const EVMBlock& block,
-                                                          const std::vector<EVMTransaction>& transactions);
+  /**
+   * @brief Executes transactions and decodes results straight from EVM output into receipts, so logs are not copied
+   *        through intermediate ExecutionResult objects
+   * @param receipts receipts of executed transactions are appended to it
+   */
+  void execute_transactions(const EVMBlock& block, const std::vector<EVMTransaction>& transactions,
+                            final_chain::TransactionReceipts& receipts);
   const RewardsDistributionResult& distribute_rewards(const std::vector<rewards::BlockStats>& rewards_stats);
   void transition_state_commit();
 
@@ -57,6 +72,7 @@ class StateAPI {
   // DPOS
   uint64_t dpos_eligible_total_vote_count(EthBlockNumber blk_num) const;
   uint64_t dpos_eligible_vote_count(EthBlockNumber blk_num, const addr_t& addr) const;
+  std::vector<uint64_t> dpos_eligible_vote_counts(EthBlockNumber blk_num, const std::vector<addr_t>& addrs) const;
   bool dpos_is_eligible(EthBlockNumber blk_num, const addr_t& addr) const;
   u256 get_staking_balance(EthBlockNumber blk_num, const addr_t& addr) const;
   vrf_wrapper::vrf_pk_t dpos_get_vrf_key(EthBlockNumber blk_num, const addr_t& addr) const;
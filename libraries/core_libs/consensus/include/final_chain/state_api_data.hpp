@@ -70,12 +70,6 @@ struct ExecutionResult {
   HAS_RLP_FIELDS
 };
 
-struct TransactionsExecutionResult {
-  std::vector<ExecutionResult> execution_results;
-
-  HAS_RLP_FIELDS
-};
-
 struct RewardsDistributionResult {
   h256 state_root;
   u256 total_reward;
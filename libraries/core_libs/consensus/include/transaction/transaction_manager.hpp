@@ -1,6 +1,10 @@
 #pragma once
 
+#include <boost/asio/thread_pool.hpp>
+
 #include "common/event.hpp"
+#include "common/thread_pool.hpp"
+#include "final_chain/cache.hpp"
 #include "final_chain/final_chain.hpp"
 #include "logger/logger.hpp"
 #include "storage/storage.hpp"
@@ -52,15 +56,33 @@ class TransactionManager : public std::enable_shared_from_this<TransactionManage
  public:
   TransactionManager(const FullNodeConfig &conf, std::shared_ptr<DbStorage> db,
                      std::shared_ptr<final_chain::FinalChain> final_chain, addr_t node_addr);
+  ~TransactionManager();
 
   /**
-   * @brief Estimates required gas value to execute transaction
+   * @brief Estimates required gas value to execute transaction. Estimations at specified proposal period are cached,
+   * so the same transaction is not executed again when it is proposed and verified in dag blocks of the same period
    * @param trx transaction
    * @param proposal_period proposal period
    * @return estimated gas value for transaction
    */
   uint64_t estimateTransactionGas(std::shared_ptr<Transaction> trx, std::optional<PbftPeriod> proposal_period) const;
 
+  /**
+   * @brief Estimates required gas values of transactions batch in parallel on gas estimation pool
+   * @param trxs transactions
+   * @param proposal_period proposal period
+   * @return estimated gas values in the same order as transactions
+   */
+  std::vector<uint64_t> estimateTransactionsGas(const SharedTransactions &trxs,
+                                                std::optional<PbftPeriod> proposal_period) const;
+
+  CacheStats gasEstimationCacheStats() const { return gas_estimation_cache_.stats(); }
+
+  /**
+   * @return total time in microseconds spent in evm dry runs of gas estimation
+   */
+  uint64_t gasEstimationTimeUs() const { return gas_estimation_time_us_; }
+
   /**
    * @brief Gets transactions from pool to include in the block with specified weight limit
    * @param proposal_period proposal period
@@ -220,11 +242,32 @@ class TransactionManager : public std::enable_shared_from_this<TransactionManage
   std::shared_ptr<Transaction> getNonFinalizedTransaction(const trx_hash_t &hash) const;
   unsigned long getTransactionCount() const;
   void recoverNonfinalizedTransactions();
+
+  /**
+   * @brief Verifies and inserts transactions saved in pool journal into transactions pool, does nothing if pool
+   * journal is disabled. Must be called after recoverNonfinalizedTransactions, so transactions already included in dag
+   * are not inserted in pool again
+   */
+  void restorePoolJournal();
   std::pair<bool, std::string> verifyTransaction(const std::shared_ptr<Transaction> &trx) const;
 
+  /**
+   * @brief Recovers senders of transactions batch on sender recovery pool, so following verifyTransaction calls don't
+   * do signature recovery one by one on the calling thread. Recovered senders are cached in transactions
+   *
+   * @param trxs transactions to recover senders of
+   */
+  void recoverSenders(const SharedTransactions &trxs) const;
+
  private:
   addr_t getFullNodeAddress() const;
 
+  /**
+   * @brief Appends transactions inserted in pool since last flush to pool journal, every kJournalCompactionFlushes
+   * flushes also removes transactions that already left the pool from journal
+   */
+  void flushPoolJournal();
+
  public:
   util::Event<TransactionManager, h256> const transaction_accepted_{};
 
@@ -244,9 +287,35 @@ class TransactionManager : public std::enable_shared_from_this<TransactionManage
   const uint64_t kEstimateGasLimit = 200000;
   const uint64_t kRecentlyFinalizedTransactionsMax = 50000;
 
+  // Minimal number of transactions recovered by single task, smaller batches are not worth dispatching
+  static constexpr size_t kMinTrxsPerRecoveryTask = 8;
+  const uint32_t kSenderRecoveryThreads;
+  // Recovers senders of received transactions batches, null if parallel recovery is disabled
+  std::unique_ptr<boost::asio::thread_pool> sender_recovery_pool_;
+
+  static constexpr size_t kMinTrxsPerEstimationTask = 2;
+  static constexpr uint64_t kGasEstimationCacheBlocks = 10;
+  // Number of transactions estimated at once while packing a block, packing stops at the first chunk over weight limit
+  static constexpr size_t kTrxsPerPackingChunk = 32;
+  const uint32_t kGasEstimationThreads;
+  // Estimates gas of dag block transactions batches, null if parallel estimation is disabled
+  std::unique_ptr<boost::asio::thread_pool> gas_estimation_pool_;
+  // Gas estimations by proposal period and transaction hash, failed estimations are cached as 0
+  MapByBlockCache<trx_hash_t, std::optional<uint64_t>> gas_estimation_cache_;
+  mutable std::atomic<uint64_t> gas_estimation_time_us_ = 0;
+
   std::shared_ptr<DbStorage> db_{nullptr};
   std::shared_ptr<final_chain::FinalChain> final_chain_{nullptr};
 
+  static constexpr uint64_t kJournalFlushPeriodMs = 1000;
+  static constexpr uint64_t kJournalCompactionFlushes = 60;
+  // Transactions inserted in pool and not yet written to pool journal
+  std::mutex journal_mutex_;
+  SharedTransactions journal_pending_;
+  uint64_t journal_flushes_ = 0;
+  // Writes pool journal in background, null if pool journal is disabled
+  std::unique_ptr<util::ThreadPool> journal_worker_;
+
   LOG_OBJECTS_DEFINE
 };
 
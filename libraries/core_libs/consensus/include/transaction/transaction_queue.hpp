@@ -1,5 +1,10 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <set>
+#include <shared_mutex>
+
 #include "common/constants.hpp"
 #include "common/util.hpp"
 #include "transaction/transaction.hpp"
@@ -23,8 +28,10 @@ class FinalChain;
  * transactions. Non proposable transactions can expire if no DAG block that contains them is received within the
  * kNonProposableTransactionsPeriodExpiryLimit.
  *
- * This is NOT thread safe class. It is proteced only by transactions_mutex_
- * in the TransactionsManager !!!
+ * Class is thread safe. Accounts transactions are spread over shards by sender and transactions by hash over shards by
+ * hash, so inserts and lookups of different transactions run in parallel. Account shard lock is always taken before
+ * hash shard lock. Only proposal selection and getAllTransactions lock all account shards to get a consistent
+ * snapshot.
  *
  */
 class TransactionQueue {
@@ -58,8 +65,8 @@ class TransactionQueue {
   std::shared_ptr<Transaction> get(const trx_hash_t& hash) const;
 
   /**
-   * @brief returns up to the number of requested transaction sorted by priority. This call actually sorts the
-   * transaction so it is expensive and should be used only when needed
+   * @brief returns up to the number of requested transaction sorted by priority. Accounts are kept ordered by gas price
+   * of their lowest nonce transaction, so selection of count transactions costs O(count * log(accounts))
    *
    * @param count
    * @return std::vector<std::shared_ptr<Transaction>>
@@ -123,7 +130,7 @@ class TransactionQueue {
    * @return Returns true if txs were dropped
    */
   bool transactionsDropped() const {
-    return std::chrono::system_clock::now() - transaction_overflow_time_ < kTransactionOverflowTimeLimit;
+    return std::chrono::system_clock::now() - transaction_overflow_time_.load() < kTransactionOverflowTimeLimit;
   }
 
   /**
@@ -135,20 +142,64 @@ class TransactionQueue {
   bool nonProposableTransactionsOverTheLimit() const;
 
  private:
-  // Transactions in the queue per account ordered by nonce
-  std::unordered_map<addr_t, std::map<val_t, std::shared_ptr<Transaction>>> account_nonce_transactions_;
+  using NonceTransactions = std::map<val_t, std::shared_ptr<Transaction>>;
+
+  struct alignas(64) AccountsShard {
+    mutable std::shared_mutex mutex;
+    // Transactions in the queue per account ordered by nonce
+    std::unordered_map<addr_t, NonceTransactions> account_nonce_transactions;
+    // Accounts ordered by gas price of their lowest nonce transaction, updated on every change of account transactions
+    std::set<std::pair<val_t, addr_t>, std::greater<>> accounts_by_head_gas_price;
+
+    /**
+     * @brief Updates account position in head gas price index after its transactions were changed, shard must be locked
+     * @param old_head lowest nonce transaction of account before the change, null if account had no transactions
+     */
+    void updateAccountIndex(const addr_t& sender, const std::shared_ptr<Transaction>& old_head,
+                            const NonceTransactions& transactions);
+  };
+
+  struct alignas(64) HashShard {
+    mutable std::shared_mutex mutex;
+    // Transactions in the queue per trx hash
+    std::unordered_map<trx_hash_t, std::shared_ptr<Transaction>> queue_transactions;
+    // Low nonce and insufficient balance transactions which should not be included in proposed dag blocks but it is
+    // possible because of dag reordering that some dag block might arrive requiring these transactions.
+    std::unordered_map<trx_hash_t, std::pair<uint64_t, std::shared_ptr<Transaction>>> non_proposable_transactions;
+  };
+
+  AccountsShard& accountsShard(const addr_t& sender) const;
+  HashShard& hashShard(const trx_hash_t& hash) const;
+
+  /**
+   * @brief Inserts transaction to non proposable transactions, hash shard must be locked
+   */
+  bool insertNonProposable(HashShard& shard, const std::shared_ptr<Transaction>& transaction,
+                           uint64_t last_block_number);
+
+  /**
+   * @brief Drops 1% of transactions with the lowest priority if queue is over the max size
+   */
+  void dropLowestPriorityTransactions();
+
+  /**
+   * @brief Locks all account shards, so they can be read consistently
+   */
+  std::vector<std::shared_lock<std::shared_mutex>> lockAccountsShards() const;
 
-  // Transactions in the queue per trx hash
-  std::unordered_map<trx_hash_t, std::shared_ptr<Transaction>> queue_transactions_;
+  static constexpr size_t kShardsCount = 16;
+  mutable std::array<AccountsShard, kShardsCount> accounts_shards_;
+  mutable std::array<HashShard, kShardsCount> hash_shards_;
+  std::atomic<size_t> queue_size_ = 0;
+  std::atomic<size_t> non_proposable_size_ = 0;
 
-  // Low nonce and insufficient balance transactions which should not be included in proposed dag blocks but it is
-  // possible because of dag reordering that some dag block might arrive requiring these transactions.
-  std::unordered_map<trx_hash_t, std::pair<uint64_t, std::shared_ptr<Transaction>>> non_proposable_transactions_;
+  // Serializes dropping of transactions when queue is over the max size
+  std::mutex overflow_mutex_;
 
   ExpirationCache<trx_hash_t> known_txs_;
 
   // Last time transactions were dropped due to queue reaching max size
-  std::chrono::system_clock::time_point transaction_overflow_time_;
+  std::atomic<std::chrono::system_clock::time_point> transaction_overflow_time_;
 
   // If transactions are dropped within last kTransactionOverflowTimeLimit seconds, dag blocks with missing transactions
   // will not be treated as malicious
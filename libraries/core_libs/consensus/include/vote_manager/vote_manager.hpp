@@ -186,6 +186,14 @@ class VoteManager {
    */
   std::pair<bool, std::string> validateVote(const std::shared_ptr<PbftVote>& vote, bool strict = true) const;
 
+  /**
+   * @brief Reads dpos eligible vote counts of all voters with one batch per period, so following validateVote calls
+   *        get them from final chain cache
+   *
+   * @param votes to be validated
+   */
+  void prefetchVotersVoteCounts(const std::vector<std::shared_ptr<PbftVote>>& votes) const;
+
   /**
    * @brief Get 2t+1. 2t+1 is 2/3 of PBFT sortition threshold and plus 1 for a specific period
    * @param pbft_period pbft period
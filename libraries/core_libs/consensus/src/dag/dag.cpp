@@ -4,14 +4,9 @@
 
 #include <algorithm>
 #include <fstream>
-#include <stack>
-#include <tuple>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
-#include "dag/dag.hpp"
-
 namespace taraxa {
 
 Dag::Dag(blk_hash_t const &dag_genesis_block_hash, addr_t node_addr) {
@@ -21,39 +16,32 @@ Dag::Dag(blk_hash_t const &dag_genesis_block_hash, addr_t node_addr) {
   addVEEs(dag_genesis_block_hash, {}, tips);
 }
 
-uint64_t Dag::getNumVertices() const { return boost::num_vertices(graph_); }
-uint64_t Dag::getNumEdges() const { return boost::num_edges(graph_); }
+uint64_t Dag::getNumVertices() const { return vertices_.size(); }
+uint64_t Dag::getNumEdges() const { return edges_count_; }
 
-bool Dag::hasVertex(blk_hash_t const &v) const { return graph_.vertex(v) != graph_.null_vertex(); }
+bool Dag::hasVertex(blk_hash_t const &v) const { return vertex_ids_.contains(v); }
 
 void Dag::getLeaves(std::vector<blk_hash_t> &tips) const {
-  vertex_index_map_const_t index_map = boost::get(boost::vertex_index, graph_);
   std::vector<vertex_t> leaves;
   collectLeafVertices(leaves);
   std::transform(leaves.begin(), leaves.end(), std::back_inserter(tips),
-                 [index_map](const vertex_t &leaf) { return index_map[leaf]; });
+                 [this](const vertex_t &leaf) { return vertices_[leaf]; });
 }
 
 bool Dag::addVEEs(blk_hash_t const &new_vertex, blk_hash_t const &pivot, std::vector<blk_hash_t> const &tips) {
   assert(!new_vertex.isZero());
 
   // add vertex
-  vertex_t ret = add_vertex(new_vertex, graph_);
-  boost::get(boost::vertex_index, graph_)[ret] = new_vertex;
-  // TODO do we need this?
-  // edge_index_map_t weight_map = boost::get(boost::edge_index, graph_);
+  const auto ret = addVertex(new_vertex);
 
-  edge_t edge;
   bool res = true;
 
   // Note: add edges,
   // *** important
   // Add a new block, edges are pointing from pivot to new_vertex
   if (!pivot.isZero()) {
-    if (hasVertex(pivot)) {
-      std::tie(edge, res) = boost::add_edge_by_label(pivot, new_vertex, graph_);
-      // TODO do we need this?
-      // weight_map[edge] = 1;
+    if (const auto pivot_vertex = vertex(pivot); pivot_vertex != kNullVertex) {
+      res = addEdge(pivot_vertex, ret);
       if (!res) {
         LOG(log_wr_) << "Creating pivot edge \n" << pivot << "\n-->\n" << new_vertex << " \nunsuccessful!" << std::endl;
       }
@@ -61,10 +49,8 @@ bool Dag::addVEEs(blk_hash_t const &new_vertex, blk_hash_t const &pivot, std::ve
   }
   bool res2 = true;
   for (auto const &e : tips) {
-    if (hasVertex(e)) {
-      std::tie(edge, res2) = boost::add_edge_by_label(e, new_vertex, graph_);
-      // TODO do we need this?
-      // weight_map[edge] = 0;
+    if (const auto tip_vertex = vertex(e); tip_vertex != kNullVertex) {
+      res2 = addEdge(tip_vertex, ret);
       if (!res2) {
         LOG(log_wr_) << "Creating tip edge \n" << e << "\n-->\n" << new_vertex << " \nunsuccessful!" << std::endl;
       }
@@ -76,24 +62,62 @@ bool Dag::addVEEs(blk_hash_t const &new_vertex, blk_hash_t const &pivot, std::ve
 
 void Dag::drawGraph(std::string const &filename) const {
   std::ofstream outfile(filename.c_str());
-  auto index_map = boost::get(boost::vertex_index, graph_);
-  auto weight_map = boost::get(boost::edge_index, graph_);
-
-  boost::write_graphviz(outfile, graph_, vertex_label_writer(index_map), edge_label_writer(weight_map));
+  outfile << "digraph G {" << std::endl;
+  for (vertex_t v = 0; v < vertices_.size(); ++v) {
+    outfile << v << "[label=\"" << vertices_[v].toString().substr(0, 8) << " \"];" << std::endl;
+  }
+  for (vertex_t v = 0; v < vertices_.size(); ++v) {
+    for (const auto child : children_[v]) {
+      outfile << v << "->" << child << " [style=\"dashed\" dir=\"back\"];" << std::endl;
+    }
+  }
+  outfile << "}" << std::endl;
   std::cout << "Dot file " << filename << " generated!" << std::endl;
   std::cout << "Use \"dot -Tpdf <dot file> -o <pdf file>\" to generate pdf file" << std::endl;
 }
 
-void Dag::clear() { graph_ = graph_t(); }
+void Dag::clear() {
+  vertices_.clear();
+  children_.clear();
+  parents_.clear();
+  vertex_ids_.clear();
+  edges_count_ = 0;
+}
+
+Dag::vertex_t Dag::vertex(blk_hash_t const &hash) const {
+  const auto it = vertex_ids_.find(hash);
+  return it == vertex_ids_.end() ? kNullVertex : it->second;
+}
+
+Dag::vertex_t Dag::addVertex(blk_hash_t const &hash) {
+  const auto [it, inserted] = vertex_ids_.try_emplace(hash, vertices_.size());
+  if (inserted) {
+    vertices_.emplace_back(hash);
+    children_.emplace_back();
+    parents_.emplace_back();
+  }
+  return it->second;
+}
+
+bool Dag::addEdge(vertex_t from, vertex_t to) {
+  // Vertex has only pivot and tips as parents, so checking its parents for duplicate is cheaper than children of pivot
+  auto &parents = parents_[to];
+  if (std::find(parents.begin(), parents.end(), from) != parents.end()) {
+    return false;
+  }
+  parents.emplace_back(from);
+  children_[from].emplace_back(to);
+  edges_count_++;
+  return true;
+}
 
 void Dag::collectLeafVertices(std::vector<vertex_t> &leaves) const {
   leaves.clear();
-  vertex_iter_t s, e;
   // iterator all vertex
-  for (std::tie(s, e) = boost::vertices(graph_); s != e; ++s) {
+  for (vertex_t v = 0; v < vertices_.size(); ++v) {
     // if out-degree zero, leaf node
-    if (boost::out_degree(*s, graph_) == 0) {
-      leaves.emplace_back(*s);
+    if (children_[v].empty()) {
+      leaves.emplace_back(v);
     }
   }
   assert(leaves.size());
@@ -102,66 +126,84 @@ void Dag::collectLeafVertices(std::vector<vertex_t> &leaves) const {
 // only iterate through non finalized blocks
 bool Dag::computeOrder(const blk_hash_t &anchor, std::vector<blk_hash_t> &ordered_period_vertices,
                        const std::map<uint64_t, std::unordered_set<blk_hash_t>> &non_finalized_blks) {
-  vertex_t target = graph_.vertex(anchor);
+  const auto target = vertex(anchor);
 
-  if (target == graph_.null_vertex()) {
+  if (target == kNullVertex) {
     LOG(log_wr_) << "Dag::ComputeOrder cannot find vertex (anchor) " << anchor << "\n";
     return false;
   }
   ordered_period_vertices.clear();
 
-  vertex_iter_t s, e;
-  vertex_index_map_t index_map = boost::get(boost::vertex_index, graph_);  // from vertex_descriptor to hash
-  std::map<blk_hash_t, vertex_t> epfriend;                                 // this is unordered epoch
-  epfriend[index_map[target]] = target;
-
-  // Step 1: collect all epoch blks that can reach anchor
-  // Erase from recent_added_blks after mark epoch number if finalized
-
+  std::vector<bool> non_finalized(vertices_.size());
   for (auto &l : non_finalized_blks) {
     for (auto &blk : l.second) {
-      auto v = graph_.vertex(blk);
-      if (reachable(v, target)) {
-        epfriend[index_map[v]] = v;
+      if (const auto v = vertex(blk); v != kNullVertex) {
+        non_finalized[v] = true;
       }
     }
   }
+
+  // Step 1: collect all epoch blks that can reach anchor, single walk over edges backwards from anchor finds all of
+  // them instead of checking reachability of anchor from every non finalized block
+  std::vector<bool> in_epoch(vertices_.size());
+  std::vector<bool> visited(vertices_.size());
+  std::vector<vertex_t> epfriend{target};  // this is unordered epoch
+  std::vector<vertex_t> st{target};
+  in_epoch[target] = true;
+  visited[target] = true;
+  while (!st.empty()) {
+    const auto cur = st.back();
+    st.pop_back();
+    for (const auto parent : parents_[cur]) {
+      if (visited[parent]) {
+        continue;
+      }
+      visited[parent] = true;
+      st.emplace_back(parent);
+      if (non_finalized[parent]) {
+        in_epoch[parent] = true;
+        epfriend.emplace_back(parent);
+      }
+    }
+  }
+  const auto by_hash = [this](vertex_t a, vertex_t b) { return vertices_[a] < vertices_[b]; };
+  std::sort(epfriend.begin(), epfriend.end(), by_hash);
+
   // Step2: compute topological order of epfriend
-  std::unordered_set<vertex_t> visited;
-  std::stack<std::pair<vertex_t, bool>> dfs;
-  vertex_adj_iter_t adj_s, adj_e;
+  std::fill(visited.begin(), visited.end(), false);
+  std::vector<std::pair<vertex_t, bool>> dfs;
+  std::vector<vertex_t> neighbors;
 
-  for (auto const &vp : epfriend) {
-    auto const &v = vp.second;
-    if (visited.count(v)) {
+  for (const auto v : epfriend) {
+    if (visited[v]) {
       continue;
     }
-    dfs.push({v, false});
-    visited.insert(v);
+    dfs.emplace_back(v, false);
+    visited[v] = true;
     while (!dfs.empty()) {
-      auto cur = dfs.top();
-      dfs.pop();
+      const auto cur = dfs.back();
+      dfs.pop_back();
       if (cur.second) {
-        ordered_period_vertices.emplace_back(index_map[cur.first]);
+        ordered_period_vertices.emplace_back(vertices_[cur.first]);
         continue;
       }
-      dfs.push({cur.first, true});
-      std::vector<std::pair<blk_hash_t, vertex_t>> neighbors;
+      dfs.emplace_back(cur.first, true);
+      neighbors.clear();
       // iterate through neighbors
-      for (std::tie(adj_s, adj_e) = boost::adjacent_vertices(cur.first, graph_); adj_s != adj_e; adj_s++) {
-        if (epfriend.find(index_map[*adj_s]) == epfriend.end()) {  // not in this epoch
+      for (const auto child : children_[cur.first]) {
+        if (!in_epoch[child]) {  // not in this epoch
           continue;
         }
-        if (visited.count(*adj_s)) {
+        if (visited[child]) {
           continue;
         }
-        neighbors.emplace_back(std::make_pair(index_map[*adj_s], *adj_s));
-        visited.insert(*adj_s);
+        neighbors.emplace_back(child);
+        visited[child] = true;
       }
       // make sure iterated nodes have deterministic order
-      std::sort(neighbors.begin(), neighbors.end());
-      for (auto const &n : neighbors) {
-        dfs.push({n.second, false});
+      std::sort(neighbors.begin(), neighbors.end(), by_hash);
+      for (const auto n : neighbors) {
+        dfs.emplace_back(n, false);
       }
     }
   }
@@ -169,95 +211,80 @@ bool Dag::computeOrder(const blk_hash_t &anchor, std::vector<blk_hash_t> &ordere
   return true;
 }
 
-// dfs
-bool Dag::reachable(vertex_t const &from, vertex_t const &to) const {
-  if (from == to) return true;
-  vertex_t current = from;
-  vertex_t target = to;
-  std::stack<vertex_t> st;
-  std::set<vertex_t> visited;
-  st.push(current);
-  visited.insert(current);
+bool PivotTree::addEdge(vertex_t from, vertex_t to) {
+  if (!Dag::addEdge(from, to)) {
+    return false;
+  }
+  if (weights_deferred_) {
+    return true;
+  }
+  // Vertices without children have weight 1, genesis/anchor vertex is added before any edge
+  weights_.resize(vertices_.size(), 1);
 
+  // Subtree of the new child becomes part of subtrees of all its ancestors
+  const auto added_weight = weights_[to];
+  std::vector<vertex_t> st{from};
   while (!st.empty()) {
-    vertex_t t = st.top();
-    st.pop();
-    vertex_adj_iter_t s, e;
-    for (std::tie(s, e) = boost::adjacent_vertices(t, graph_); s != e; ++s) {
-      if (visited.count(*s)) continue;
-      if (*s == target) return true;
-      visited.insert(*s);
-      st.push(*s);
-    }
+    const auto cur = st.back();
+    st.pop_back();
+    weights_[cur] += added_weight;
+    st.insert(st.end(), parents_[cur].begin(), parents_[cur].end());
   }
-  return false;
+  return true;
 }
 
-/**
- * Iterative version
- * Steps rounds
- * 1. post order traversal
- * 2. from leave, count weight and propagate up
- * 3. collect path
- */
-
-std::vector<blk_hash_t> PivotTree::getGhostPath(const blk_hash_t &vertex) const {
-  vertex_t root = graph_.vertex(vertex);
+void PivotTree::clear() {
+  Dag::clear();
+  weights_.clear();
+}
 
-  if (root == graph_.null_vertex()) {
-    LOG(log_wr_) << "Cannot find vertex (getGhostPath) " << vertex << std::endl;
-    return {};
-  }
+void PivotTree::deferWeights() { weights_deferred_ = true; }
 
-  std::vector<blk_hash_t> pivot_chain;
-  std::vector<vertex_t> post_order;
+void PivotTree::rebuildWeights() {
+  weights_deferred_ = false;
+  weights_.assign(vertices_.size(), 1);
 
-  // first step: post order traversal
-  std::stack<vertex_t> st;
-  st.emplace(root);
-  vertex_t cur;
-  vertex_adj_iter_t s, e;
-  while (!st.empty()) {
-    cur = st.top();
-    st.pop();
-    post_order.emplace_back(cur);
-    for (std::tie(s, e) = boost::adjacent_vertices(cur, graph_); s != e; s++) {
-      st.emplace(*s);
+  // Order vertices from roots, so children are summed before their parent when walked backwards
+  std::vector<vertex_t> order;
+  order.reserve(vertices_.size());
+  for (vertex_t v = 0; v < vertices_.size(); ++v) {
+    if (parents_[v].empty()) {
+      order.emplace_back(v);
     }
   }
-  std::reverse(post_order.begin(), post_order.end());
-
-  // second step: compute weight based on step one
-  std::unordered_map<vertex_t, size_t> weight_map;
-  for (auto const &n : post_order) {
-    auto total_w = 0;
-    // get childrens
-    for (std::tie(s, e) = boost::adjacent_vertices(n, graph_); s != e; s++) {
-      if (weight_map.count(*s)) {  // bigger timestamp
-        total_w += weight_map[*s];
-      }
+  for (size_t i = 0; i < order.size(); ++i) {
+    order.insert(order.end(), children_[order[i]].begin(), children_[order[i]].end());
+  }
+  for (auto it = order.rbegin(); it != order.rend(); ++it) {
+    for (const auto parent : parents_[*it]) {
+      weights_[parent] += weights_[*it];
     }
-    weight_map[n] = total_w + 1;
   }
+}
 
-  vertex_index_map_const_t index_map = boost::get(boost::vertex_index, graph_);
+std::vector<blk_hash_t> PivotTree::getGhostPath(const blk_hash_t &vertex) const {
+  auto root = Dag::vertex(vertex);
+
+  if (root == kNullVertex) {
+    LOG(log_wr_) << "Cannot find vertex (getGhostPath) " << vertex << std::endl;
+    return {};
+  }
 
-  // third step: collect path
+  std::vector<blk_hash_t> pivot_chain;
   while (1) {
-    pivot_chain.emplace_back(index_map[root]);
+    pivot_chain.emplace_back(vertices_[root]);
     size_t heavist = 0;
     vertex_t next = root;
 
-    for (std::tie(s, e) = boost::adjacent_vertices(root, graph_); s != e; s++) {
-      if (!weight_map.count(*s)) continue;  // bigger timestamp
-      size_t w = weight_map[*s];
-      assert(w > 0);
+    for (const auto child : children_[root]) {
+      const auto w = weights_[child];
+      if (w == 0) continue;  // weights are not computed yet
       if (w > heavist) {
         heavist = w;
-        next = *s;
+        next = child;
       } else if (w == heavist) {
-        if (index_map[*s] < index_map[next]) {
-          next = *s;
+        if (vertices_[child] < vertices_[next]) {
+          next = child;
         }
       }
     }
@@ -8,6 +8,7 @@
 #include <utility>
 #include <vector>
 
+#include "common/util.hpp"
 #include "config/config.hpp"
 #include "dag/dag.hpp"
 #include "key_manager/key_manager.hpp"
@@ -37,8 +38,12 @@ DagManager::DagManager(const FullNodeConfig &config, addr_t node_addr, std::shar
       final_chain_(std::move(final_chain)),
       kGenesis(config.genesis),
       kValidatorMaxVote(config.genesis.state.dpos.validator_maximum_stake /
-                        config.genesis.state.dpos.vote_eligibility_balance_step) {
+                        config.genesis.state.dpos.vote_eligibility_balance_step),
+      kVerificationThreads(config.dag_verification_threads) {
   LOG_OBJECTS_CREATE("DAGMGR");
+  if (kVerificationThreads) {
+    verification_pool_ = std::make_unique<boost::asio::thread_pool>(kVerificationThreads);
+  }
   if (auto ret = getLatestPivotAndTips(); ret) {
     frontier_.pivot = ret->first;
     for (const auto &t : ret->second) {
@@ -138,9 +143,10 @@ std::pair<bool, std::vector<blk_hash_t>> DagManager::addDagBlock(const std::shar
     // correct order since multiple threads can call this method. There is a need for using two mutexes since having
     // blocks gossip under mutex_ leads to a deadlock with mutex in TaraxaPeer
     std::scoped_lock order_lock(order_dag_blocks_mutex_);
-    {
-      std::scoped_lock lock(mutex_);
-      if (save) {
+    if (save) {
+      PbftPeriod checked_period = 0;
+      {
+        std::shared_lock lock(mutex_);
         if (db_->dagBlockInDb(blk->getHash())) {
           // It is a valid scenario that two threads can receive same block from two peers and process at same time
           return {true, {}};
@@ -156,24 +162,40 @@ std::pair<bool, std::vector<blk_hash_t>> DagManager::addDagBlock(const std::shar
         if (!res.first) {
           return res;
         }
-        // Saves transactions and remove them from memory pool
-        trx_mgr_->saveTransactionsFromDagBlock(trxs);
-        // Save the dag block
-        db_->saveDagBlock(blk);
+        checked_period = period_;
       }
-      seen_blocks_.insert(blk->getHash(), blk);
-      auto pivot_hash = blk->getPivot();
-
-      std::vector<blk_hash_t> tips = blk->getTips();
-      level_t current_max_level = max_level_;
-      max_level_ = std::max(current_max_level, blk->getLevel());
-
-      addToDag(blk_hash, pivot_hash, tips, blk->getLevel());
-      if (non_finalized_blks_min_difficulty_ > blk->getDifficulty()) {
-        non_finalized_blks_min_difficulty_ = blk->getDifficulty();
+      // Block and transactions are written outside of mutex_ so finalization and readers of the DAG are not blocked by
+      // db writes, order_dag_blocks_mutex_ still serializes writers of dag blocks
+      // Saves transactions and remove them from memory pool
+      trx_mgr_->saveTransactionsFromDagBlock(trxs);
+      // Save the dag block
+      db_->saveDagBlock(blk);
+
+      std::unique_lock lock(mutex_);
+      if (period_ != checked_period) {
+        // Period was finalized while block was saved, block could be finalized from synced period data or expired
+        if (db_->getDagBlockPeriod(blk_hash)) {
+          db_->removeDagBlock(blk_hash);
+          return {true, {}};
+        }
+        if (blk->getLevel() < dag_expiry_level_ || !pivotAndTipsAvailable(blk).first) {
+          LOG(log_nf_) << "Dropping block expired while it was saved: " << blk_hash
+                       << ". Expiry level: " << dag_expiry_level_ << ". Block level: " << blk->getLevel();
+          db_->removeDagBlock(blk_hash);
+          seen_blocks_.erase(blk_hash);
+          // Transactions mutex is locked after mutex_ same as on pbft block finalization
+          std::unique_lock trx_lock(trx_mgr_->getTransactionsMutex());
+          handleExpiredDagBlocksTransactions(blk->getTrxs());
+          return {false, {}};
+        }
+        // Expired blocks removed by finalization could share transactions with this block, which was not in the DAG
+        // yet to keep them, so transactions are saved again now when the block is inserted atomically with them
+        trx_mgr_->saveTransactionsFromDagBlock(trxs);
       }
-
-      updateFrontier();
+      insertDagBlock(blk);
+    } else {
+      std::unique_lock lock(mutex_);
+      insertDagBlock(blk);
     }
     if (save) {
       block_verified_.emit(blk);
@@ -187,6 +209,22 @@ std::pair<bool, std::vector<blk_hash_t>> DagManager::addDagBlock(const std::shar
   return {true, {}};
 }
 
+void DagManager::insertDagBlock(const std::shared_ptr<DagBlock> &blk) {
+  seen_blocks_.insert(blk->getHash(), blk);
+  auto pivot_hash = blk->getPivot();
+
+  std::vector<blk_hash_t> tips = blk->getTips();
+  level_t current_max_level = max_level_;
+  max_level_ = std::max(current_max_level, blk->getLevel());
+
+  addToDag(blk->getHash(), pivot_hash, tips, blk->getLevel());
+  if (non_finalized_blks_min_difficulty_ > blk->getDifficulty()) {
+    non_finalized_blks_min_difficulty_ = blk->getDifficulty();
+  }
+
+  updateFrontier();
+}
+
 void DagManager::drawGraph(std::string const &dotfile) const {
   std::shared_lock lock(mutex_);
   drawPivotGraph("pivot." + dotfile);
@@ -334,13 +372,13 @@ uint DagManager::setDagBlockOrder(blk_hash_t const &new_anchor, PbftPeriod perio
   }
   // Only update counter for blocks that are in the dag_order and not in memory DAG, this is only possible when pbft
   // syncing and processing period data
-  std::vector<std::shared_ptr<DagBlock>> dag_blocks_to_update_counters;
+  std::vector<blk_hash_t> dag_blocks_hashes_to_update_counters;
   for (auto const &blk : dag_order) {
     if (non_finalized_blocks_set.count(blk) == 0) {
-      auto dag_block = getDagBlock(blk);
-      dag_blocks_to_update_counters.push_back(dag_block);
+      dag_blocks_hashes_to_update_counters.push_back(blk);
     }
   }
+  auto dag_blocks_to_update_counters = getDagBlocks(dag_blocks_hashes_to_update_counters);
 
   if (dag_blocks_to_update_counters.size()) {
     db_->updateDagBlockCounters(std::move(dag_blocks_to_update_counters));
@@ -348,6 +386,7 @@ uint DagManager::setDagBlockOrder(blk_hash_t const &new_anchor, PbftPeriod perio
 
   total_dag_->clear();
   pivot_tree_->clear();
+  pivot_tree_->deferWeights();
   auto non_finalized_blocks = std::move(non_finalized_blks_);
   non_finalized_blks_.clear();
 
@@ -386,6 +425,7 @@ uint DagManager::setDagBlockOrder(blk_hash_t const &new_anchor, PbftPeriod perio
       }
     }
   }
+  pivot_tree_->rebuildWeights();
 
   // Remove any transactions from expired dag blocks if not already finalized or included in another dag block
   if (expired_dag_blocks_transactions.size()) {
@@ -413,12 +453,13 @@ void DagManager::handleExpiredDagBlocksTransactions(
       transactions_from_expired_dag_blocks_to_remove.emplace(transactions_from_expired_dag_blocks[i]);
     }
   }
+  std::vector<blk_hash_t> non_finalized_blocks;
   for (auto const &level : non_finalized_blks_) {
-    for (auto const &blk : level.second) {
-      auto dag_block = getDagBlock(blk);
-      for (auto const &trx : dag_block->getTrxs()) {
-        transactions_from_expired_dag_blocks_to_remove.erase(trx);
-      }
+    non_finalized_blocks.insert(non_finalized_blocks.end(), level.second.begin(), level.second.end());
+  }
+  for (auto const &dag_block : getDagBlocks(non_finalized_blocks)) {
+    for (auto const &trx : dag_block->getTrxs()) {
+      transactions_from_expired_dag_blocks_to_remove.erase(trx);
     }
   }
   if (transactions_from_expired_dag_blocks_to_remove.size() > 0) {
@@ -486,6 +527,9 @@ void DagManager::recoverDag() {
   }
 
   for (auto &lvl : db_->getNonfinalizedDagBlocks()) {
+    // VDF solutions of the level blocks are verified in one batch, blocks after the first invalid one are not recovered
+    std::vector<vdf_sortition::VdfVerification> vdf_verifications;
+    vdf_verifications.reserve(lvl.second.size());
     for (auto &blk : lvl.second) {
       // These are some sanity checks that difficulty is correct and block is truly non-finalized.
       // This is only done on startup
@@ -493,37 +537,42 @@ void DagManager::recoverDag() {
       if (period != nullptr) {
         LOG(log_er_) << "Nonfinalized Dag Block actually finalized in period " << period->first;
         break;
+      }
+      auto propose_period = db_->getProposalPeriodForDagLevel(blk->getLevel());
+      if (!propose_period.has_value()) {
+        LOG(log_er_) << "No propose period for dag level " << blk->getLevel() << " found";
+        assert(false);
+        break;
+      }
+
+      const auto pk = key_manager_->getVrfKey(*propose_period, blk->getSender());
+      if (!pk) {
+        LOG(log_er_) << "DAG block " << blk->getHash() << " with " << blk->getLevel()
+                     << " level is missing VRF key for sender " << blk->getSender();
+        break;
+      }
+      uint64_t max_vote_count = 0;
+      const auto vote_count = final_chain_->dposEligibleVoteCount(*propose_period, blk->getSender());
+      if (*propose_period < kGenesis.state.hardforks.magnolia_hf.block_num) {
+        max_vote_count = final_chain_->dposEligibleTotalVoteCount(*propose_period);
       } else {
-        auto propose_period = db_->getProposalPeriodForDagLevel(blk->getLevel());
-        if (!propose_period.has_value()) {
-          LOG(log_er_) << "No propose period for dag level " << blk->getLevel() << " found";
-          assert(false);
-          break;
-        }
+        max_vote_count = kValidatorMaxVote;
+      }
+      vdf_verifications.push_back(blk->getVdfVerification(sortition_params_manager_.getSortitionParams(*propose_period),
+                                                          db_->getPeriodBlockHash(*propose_period), *pk, vote_count,
+                                                          max_vote_count));
+    }
 
-        const auto pk = key_manager_->getVrfKey(*propose_period, blk->getSender());
-        if (!pk) {
-          LOG(log_er_) << "DAG block " << blk->getHash() << " with " << blk->getLevel()
-                       << " level is missing VRF key for sender " << blk->getSender();
-          break;
-        }
-        // Verify VDF solution
-        try {
-          uint64_t max_vote_count = 0;
-          const auto vote_count = final_chain_->dposEligibleVoteCount(*propose_period, blk->getSender());
-          if (*propose_period < kGenesis.state.hardforks.magnolia_hf.block_num) {
-            max_vote_count = final_chain_->dposEligibleTotalVoteCount(*propose_period);
-          } else {
-            max_vote_count = kValidatorMaxVote;
-          }
-          blk->verifyVdf(sortition_params_manager_.getSortitionParams(*propose_period),
-                         db_->getPeriodBlockHash(*propose_period), *pk, vote_count, max_vote_count);
-        } catch (vdf_sortition::VdfSortition::InvalidVdfSortition const &e) {
-          LOG(log_er_) << "DAG block " << blk->getHash() << " with " << blk->getLevel()
-                       << " level failed on VDF verification with pivot hash " << blk->getPivot() << " reason "
-                       << e.what();
-          break;
-        }
+    // Verify VDF solution
+    const auto vdf_errors =
+        vdf_sortition::VdfSortition::verifyVdfs(vdf_verifications, verification_pool_.get(), kVerificationThreads);
+    for (size_t i = 0; i < vdf_errors.size(); ++i) {
+      const auto &blk = lvl.second[i];
+      if (vdf_errors[i]) {
+        LOG(log_er_) << "DAG block " << blk->getHash() << " with " << blk->getLevel()
+                     << " level failed on VDF verification with pivot hash " << blk->getPivot() << " reason "
+                     << vdf_errors[i]->what();
+        break;
       }
 
       // In case an invalid block somehow ended in DAG db, remove it
@@ -541,6 +590,7 @@ void DagManager::recoverDag() {
     }
   }
   trx_mgr_->recoverNonfinalizedTransactions();
+  trx_mgr_->restorePoolJournal();
 }
 
 const std::pair<PbftPeriod, std::map<uint64_t, std::unordered_set<blk_hash_t>>> DagManager::getNonFinalizedBlocks()
@@ -596,10 +646,52 @@ std::pair<size_t, size_t> DagManager::getNonFinalizedBlocksSize() const {
 
 std::pair<DagManager::VerifyBlockReturnType, SharedTransactions> DagManager::verifyBlock(
     const std::shared_ptr<DagBlock> &blk, const std::unordered_map<trx_hash_t, std::shared_ptr<Transaction>> &trxs) {
+  std::vector<BlockVerification> verifications;
+  verifications.push_back(prepareBlockVerification(blk, trxs));
+  verifyBlocksVdf({blk}, verifications);
+  auto &verification = verifications.front();
+  if (verification.result != VerifyBlockReturnType::Verified) {
+    return {verification.result, {}};
+  }
+  return finishBlockVerification(blk, std::move(verification));
+}
+
+std::vector<std::pair<DagManager::VerifyBlockReturnType, SharedTransactions>> DagManager::verifyBlocks(
+    const std::vector<std::shared_ptr<DagBlock>> &blks,
+    const std::unordered_map<trx_hash_t, std::shared_ptr<Transaction>> &trxs) {
+  // Every block is verified separately, VDF and DPOS verification dominate so single block is enough for a task
+  std::vector<BlockVerification> verifications(blks.size());
+  runInChunks(verification_pool_.get(), kVerificationThreads, blks.size(), 1, [&](size_t begin, size_t end) {
+    for (auto i = begin; i < end; ++i) {
+      verifications[i] = prepareBlockVerification(blks[i], trxs);
+    }
+  });
+
+  verifyBlocksVdf(blks, verifications);
+
+  std::vector<std::pair<VerifyBlockReturnType, SharedTransactions>> results(blks.size());
+  runInChunks(verification_pool_.get(), kVerificationThreads, blks.size(), 1, [&](size_t begin, size_t end) {
+    for (auto i = begin; i < end; ++i) {
+      if (verifications[i].result != VerifyBlockReturnType::Verified) {
+        results[i] = {verifications[i].result, {}};
+      } else {
+        results[i] = finishBlockVerification(blks[i], std::move(verifications[i]));
+      }
+    }
+  });
+  return results;
+}
+
+DagManager::BlockVerification DagManager::prepareBlockVerification(
+    const std::shared_ptr<DagBlock> &blk, const std::unordered_map<trx_hash_t, std::shared_ptr<Transaction>> &trxs) {
   const auto &block_hash = blk->getHash();
   vec_trx_t const &all_block_trx_hashes = blk->getTrxs();
   vec_trx_t trx_hashes_to_query;
-  SharedTransactions all_block_trxs;
+  BlockVerification verification;
+  const auto fail = [&verification](VerifyBlockReturnType result) {
+    verification.result = result;
+    return std::move(verification);
+  };
 
   // Verify tips/pivot count and uniqueness
   std::unordered_set<blk_hash_t> unique_tips_pivot;
@@ -607,13 +699,13 @@ std::pair<DagManager::VerifyBlockReturnType, SharedTransactions> DagManager::ver
   unique_tips_pivot.insert(blk->getPivot());
   if (blk->getTips().size() > kDagBlockMaxTips) {
     LOG(log_er_) << "DAG Block " << block_hash << " tips count " << blk->getTips().size() << " over the limit";
-    return {VerifyBlockReturnType::FailedTipsVerification, {}};
+    return fail(VerifyBlockReturnType::FailedTipsVerification);
   }
 
   for (auto const &tip : blk->getTips()) {
     if (!unique_tips_pivot.insert(tip).second) {
       LOG(log_er_) << "DAG Block " << block_hash << " tip " << tip << " duplicate";
-      return {VerifyBlockReturnType::FailedTipsVerification, {}};
+      return fail(VerifyBlockReturnType::FailedTipsVerification);
     }
   }
 
@@ -624,14 +716,15 @@ std::pair<DagManager::VerifyBlockReturnType, SharedTransactions> DagManager::ver
     // Cannot find the proposal period in DB yet. The slow node gets an ahead block, remove from seen_blocks
     LOG(log_nf_) << "Cannot find proposal period in DB for DAG block " << blk->getHash();
     seen_blocks_.erase(block_hash);
-    return {VerifyBlockReturnType::AheadBlock, {}};
+    return fail(VerifyBlockReturnType::AheadBlock);
   }
+  verification.propose_period = *propose_period;
 
   if (trxs.size() != 0) {
     for (auto const &tx_hash : all_block_trx_hashes) {
       auto trx_it = trxs.find(tx_hash);
       if (trx_it != trxs.end()) {
-        all_block_trxs.emplace_back(trx_it->second);
+        verification.trxs.emplace_back(trx_it->second);
       } else {
         trx_hashes_to_query.emplace_back(tx_hash);
       }
@@ -647,64 +740,92 @@ std::pair<DagManager::VerifyBlockReturnType, SharedTransactions> DagManager::ver
     LOG(log_nf_) << "Ignore block " << block_hash << " since it has missing transactions";
     // This can be a valid block so just remove it from the seen list
     seen_blocks_.erase(block_hash);
-    return {VerifyBlockReturnType::MissingTransaction, {}};
+    return fail(VerifyBlockReturnType::MissingTransaction);
   }
 
   for (auto t : transactions) {
-    all_block_trxs.emplace_back(std::move(t));
+    verification.trxs.emplace_back(std::move(t));
   }
 
   if (blk->getLevel() < dag_expiry_level_) {
     LOG(log_nf_) << "Dropping old block: " << blk->getHash() << ". Expiry level: " << dag_expiry_level_
                  << ". Block level: " << blk->getLevel();
-    return {VerifyBlockReturnType::ExpiredBlock, {}};
+    return fail(VerifyBlockReturnType::ExpiredBlock);
   }
 
-  // Verify VDF solution
+  // VDF solution is verified later in batch
   const auto pk = key_manager_->getVrfKey(*propose_period, blk->getSender());
   if (!pk) {
     LOG(log_er_) << "DAG block " << blk->getHash() << " with " << blk->getLevel()
                  << " level is missing VRF key for sender " << blk->getSender();
-    return {VerifyBlockReturnType::FailedVdfVerification, {}};
+    return fail(VerifyBlockReturnType::FailedVdfVerification);
   }
 
-  try {
-    const auto proposal_period_hash = db_->getPeriodBlockHash(*propose_period);
-    uint64_t max_vote_count = 0;
-    const auto vote_count = final_chain_->dposEligibleVoteCount(*propose_period, blk->getSender());
-    if (*propose_period < kGenesis.state.hardforks.magnolia_hf.block_num) {
-      max_vote_count = final_chain_->dposEligibleTotalVoteCount(*propose_period);
-    } else {
-      max_vote_count = kValidatorMaxVote;
+  const auto proposal_period_hash = db_->getPeriodBlockHash(*propose_period);
+  uint64_t max_vote_count = 0;
+  const auto vote_count = final_chain_->dposEligibleVoteCount(*propose_period, blk->getSender());
+  if (*propose_period < kGenesis.state.hardforks.magnolia_hf.block_num) {
+    max_vote_count = final_chain_->dposEligibleTotalVoteCount(*propose_period);
+  } else {
+    max_vote_count = kValidatorMaxVote;
+  }
+  verification.vdf = blk->getVdfVerification(sortition_params_manager_.getSortitionParams(*propose_period),
+                                             proposal_period_hash, *pk, vote_count, max_vote_count);
+  return verification;
+}
+
+void DagManager::verifyBlocksVdf(const std::vector<std::shared_ptr<DagBlock>> &blks,
+                                 std::vector<BlockVerification> &verifications) {
+  std::vector<vdf_sortition::VdfVerification> vdf_verifications;
+  std::vector<size_t> vdf_verifications_pos;
+  for (size_t i = 0; i < verifications.size(); ++i) {
+    if (verifications[i].result == VerifyBlockReturnType::Verified) {
+      vdf_verifications.push_back(std::move(*verifications[i].vdf));
+      vdf_verifications_pos.push_back(i);
     }
-    blk->verifyVdf(sortition_params_manager_.getSortitionParams(*propose_period), proposal_period_hash, *pk, vote_count,
-                   max_vote_count);
-  } catch (vdf_sortition::VdfSortition::InvalidVdfSortition const &e) {
-    LOG(log_er_) << "DAG block " << block_hash << " with " << blk->getLevel()
-                 << " level failed on VDF verification with pivot hash " << blk->getPivot() << " reason " << e.what();
-    LOG(log_er_) << "period from map: " << *propose_period << " current: " << pbft_chain_->getPbftChainSize();
-    return {VerifyBlockReturnType::FailedVdfVerification, {}};
   }
 
+  // Verify VDF solution
+  const auto vdf_errors =
+      vdf_sortition::VdfSortition::verifyVdfs(vdf_verifications, verification_pool_.get(), kVerificationThreads);
+  for (size_t i = 0; i < vdf_errors.size(); ++i) {
+    if (!vdf_errors[i]) {
+      continue;
+    }
+    const auto pos = vdf_verifications_pos[i];
+    const auto &blk = blks[pos];
+    LOG(log_er_) << "DAG block " << blk->getHash() << " with " << blk->getLevel()
+                 << " level failed on VDF verification with pivot hash " << blk->getPivot() << " reason "
+                 << vdf_errors[i]->what();
+    LOG(log_er_) << "period from map: " << verifications[pos].propose_period
+                 << " current: " << pbft_chain_->getPbftChainSize();
+    verifications[pos].result = VerifyBlockReturnType::FailedVdfVerification;
+  }
+}
+
+std::pair<DagManager::VerifyBlockReturnType, SharedTransactions> DagManager::finishBlockVerification(
+    const std::shared_ptr<DagBlock> &blk, BlockVerification &&verification) {
+  const auto &block_hash = blk->getHash();
+  const auto propose_period = verification.propose_period;
   auto dag_block_sender = blk->getSender();
   bool dpos_qualified;
   try {
-    dpos_qualified = final_chain_->dposIsEligible(*propose_period, dag_block_sender);
+    dpos_qualified = final_chain_->dposIsEligible(propose_period, dag_block_sender);
   } catch (state_api::ErrFutureBlock &c) {
-    LOG(log_er_) << "Verify proposal period " << *propose_period << " is too far ahead of DPOS. " << c.what();
+    LOG(log_er_) << "Verify proposal period " << propose_period << " is too far ahead of DPOS. " << c.what();
     return {VerifyBlockReturnType::FutureBlock, {}};
   }
   if (!dpos_qualified) {
     LOG(log_er_) << "Invalid DAG block DPOS. DAG block " << blk << " is not eligible for DPOS at period "
-                 << *propose_period << " for sender " << dag_block_sender.toString() << " current period "
+                 << propose_period << " for sender " << dag_block_sender.toString() << " current period "
                  << final_chain_->lastBlockNumber();
     return {VerifyBlockReturnType::NotEligible, {}};
   }
   {
     u256 total_block_weight = 0;
     auto block_gas_estimation = blk->getGasEstimation();
-    for (const auto &trx : all_block_trxs) {
-      total_block_weight += trx_mgr_->estimateTransactionGas(trx, propose_period);
+    for (const auto estimation : trx_mgr_->estimateTransactionsGas(verification.trxs, propose_period)) {
+      total_block_weight += estimation;
     }
 
     if (total_block_weight != block_gas_estimation) {
@@ -714,7 +835,7 @@ std::pair<DagManager::VerifyBlockReturnType, SharedTransactions> DagManager::ver
       return {VerifyBlockReturnType::IncorrectTransactionsEstimation, {}};
     }
 
-    const auto [dag_gas_limit, pbft_gas_limit] = kGenesis.getGasLimits(*propose_period);
+    const auto [dag_gas_limit, pbft_gas_limit] = kGenesis.getGasLimits(propose_period);
 
     if (total_block_weight > dag_gas_limit) {
       LOG(log_er_) << "BlockTooBig. DAG block " << blk->getHash() << " gas_limit: " << dag_gas_limit
@@ -743,7 +864,7 @@ std::pair<DagManager::VerifyBlockReturnType, SharedTransactions> DagManager::ver
 
   LOG(log_dg_) << "Verified DAG block " << blk->getHash();
 
-  return {VerifyBlockReturnType::Verified, std::move(all_block_trxs)};
+  return {VerifyBlockReturnType::Verified, std::move(verification.trxs)};
 }
 
 bool DagManager::isDagBlockKnown(const blk_hash_t &hash) const {
@@ -766,6 +887,31 @@ std::shared_ptr<DagBlock> DagManager::getDagBlock(const blk_hash_t &hash) const
   return db_->getDagBlock(hash);
 }
 
+std::vector<std::shared_ptr<DagBlock>> DagManager::getDagBlocks(const std::vector<blk_hash_t> &hashes) const {
+  std::vector<std::shared_ptr<DagBlock>> blocks(hashes.size());
+  std::vector<size_t> missing_idx;
+  std::vector<blk_hash_t> missing_hashes;
+  for (size_t i = 0; i < hashes.size(); ++i) {
+    if (auto blk = seen_blocks_.get(hashes[i]); blk.second) {
+      blocks[i] = std::move(blk.first);
+    } else if (hashes[i] == genesis_block_->getHash()) {
+      blocks[i] = genesis_block_;
+    } else {
+      missing_idx.push_back(i);
+      missing_hashes.push_back(hashes[i]);
+    }
+  }
+  if (missing_hashes.empty()) {
+    return blocks;
+  }
+
+  auto db_blocks = db_->getDagBlocks(missing_hashes);
+  for (size_t i = 0; i < missing_idx.size(); ++i) {
+    blocks[missing_idx[i]] = std::move(db_blocks[i]);
+  }
+  return blocks;
+}
+
 dev::bytes DagManager::getVdfMessage(blk_hash_t const &hash, SharedTransactions const &trxs) {
   dev::RLPStream s;
   s << hash;
@@ -1,7 +1,10 @@
 #include "final_chain/data.hpp"
 
+#include <cstring>
 #include <libdevcore/Common.h>
 #include <libdevcore/CommonJS.h>
+#include <limits>
+#include <stdexcept>
 
 #include "common/constants.hpp"
 #include "pbft/pbft_block.hpp"
@@ -76,6 +79,31 @@ LogBloom LogEntry::bloom() const {
 
 RLP_FIELDS_DEFINE(TransactionReceipt, status_code, gas_used, cumulative_gas_used, logs, new_contract_address)
 
+bool bloomContains(const LogBloom& bloom, const LogBloom& part) {
+  static_assert(LogBloom::size % sizeof(uint64_t) == 0);
+  uint64_t missing = 0;
+  for (size_t i = 0; i < LogBloom::size; i += sizeof(uint64_t)) {
+    uint64_t bloom_word, part_word;
+    memcpy(&bloom_word, bloom.data() + i, sizeof(uint64_t));
+    memcpy(&part_word, part.data() + i, sizeof(uint64_t));
+    missing |= part_word & ~bloom_word;
+  }
+  return !missing;
+}
+
+h256 blockBloomsChunkId(EthBlockNumber level, EthBlockNumber index) { return h256(index * 0xff + level); }
+
+dev::bytes logIndexKey(uint8_t kind, dev::bytesConstRef id, EthBlockNumber blk_n) {
+  dev::bytes key;
+  key.reserve(1 + id.size() + sizeof(EthBlockNumber));
+  key.push_back(kind);
+  key.insert(key.end(), id.begin(), id.end());
+  for (int shift = (sizeof(EthBlockNumber) - 1) * 8; shift >= 0; shift -= 8) {
+    key.push_back(static_cast<uint8_t>(blk_n >> shift));
+  }
+  return key;
+}
+
 LogBloom TransactionReceipt::bloom() const {
   LogBloom ret;
   for (auto const& l : logs) {
@@ -84,4 +112,95 @@ LogBloom TransactionReceipt::bloom() const {
   return ret;
 }
 
+namespace {
+// Offsets are stored big endian, so blobs don't depend on host byte order
+using ReceiptsBlobOffset = uint32_t;
+constexpr size_t kBlobOffsetSize = sizeof(ReceiptsBlobOffset);
+
+[[noreturn]] void throwMalformedBlob(const std::string& reason) {
+  throw std::runtime_error("Malformed receipts blob: " + reason);
+}
+
+ReceiptsBlobOffset readBlobOffset(bytesConstRef blob, size_t pos) {
+  return dev::fromBigEndian<ReceiptsBlobOffset>(blob.cropped(pos * kBlobOffsetSize, kBlobOffsetSize));
+}
+
+void writeBlobOffset(bytes& blob, size_t pos, ReceiptsBlobOffset offset) {
+  bytesRef out(blob.data() + pos * kBlobOffsetSize, kBlobOffsetSize);
+  dev::toBigEndian(offset, out);
+}
+
+// Returns receipts count after checking that offsets table fits into the blob and the last offset is its end
+size_t blobReceiptsCount(bytesConstRef blob) {
+  if (blob.empty()) {
+    return 0;
+  }
+  if (blob.size() < kBlobOffsetSize) {
+    throwMalformedBlob("size " + std::to_string(blob.size()) + " is less than receipts count size");
+  }
+  const size_t count = readBlobOffset(blob, 0);
+  const auto table_size = (count + 1) * kBlobOffsetSize;
+  if (table_size > blob.size()) {
+    throwMalformedBlob("offsets table of " + std::to_string(count) + " receipts exceeds blob size " +
+                       std::to_string(blob.size()));
+  }
+  if (count && readBlobOffset(blob, count) != blob.size() - table_size) {
+    throwMalformedBlob("last receipt end " + std::to_string(readBlobOffset(blob, count)) +
+                       " doesn't match data size " + std::to_string(blob.size() - table_size));
+  }
+  return count;
+}
+
+bytesConstRef blobReceipt(bytesConstRef blob, size_t count, size_t index) {
+  // Offsets are relative to the end of offsets table
+  const auto data = blob.cropped((count + 1) * kBlobOffsetSize);
+  const size_t begin = index ? readBlobOffset(blob, index) : 0;
+  const size_t end = readBlobOffset(blob, index + 1);
+  if (begin > end || end > data.size()) {
+    throwMalformedBlob("receipt " + std::to_string(index) + " range [" + std::to_string(begin) + ", " +
+                       std::to_string(end) + ") is out of data size " + std::to_string(data.size()));
+  }
+  return data.cropped(begin, end - begin);
+}
+}  // namespace
+
+bytes encodeReceiptsBlob(const std::vector<bytes>& receipts_rlp) {
+  const size_t count = receipts_rlp.size();
+  const size_t table_size = (count + 1) * kBlobOffsetSize;
+  size_t data_size = 0;
+  for (const auto& rlp : receipts_rlp) {
+    data_size += rlp.size();
+  }
+  assert(data_size <= std::numeric_limits<ReceiptsBlobOffset>::max());
+
+  bytes ret(table_size + data_size);
+  writeBlobOffset(ret, 0, count);
+  ReceiptsBlobOffset offset = 0;
+  for (size_t i = 0; i < count; ++i) {
+    memcpy(ret.data() + table_size + offset, receipts_rlp[i].data(), receipts_rlp[i].size());
+    offset += receipts_rlp[i].size();
+    writeBlobOffset(ret, i + 1, offset);
+  }
+  return ret;
+}
+
+TransactionReceipts decodeReceiptsBlob(bytesConstRef blob) {
+  const auto count = blobReceiptsCount(blob);
+  TransactionReceipts ret(count);
+  for (size_t i = 0; i < count; ++i) {
+    ret[i].rlp(dev::RLP(blobReceipt(blob, count, i)));
+  }
+  return ret;
+}
+
+std::optional<TransactionReceipt> decodeReceiptFromBlob(bytesConstRef blob, size_t index) {
+  const auto count = blobReceiptsCount(blob);
+  if (index >= count) {
+    return {};
+  }
+  TransactionReceipt ret;
+  ret.rlp(dev::RLP(blobReceipt(blob, count, index)));
+  return ret;
+}
+
 }  // namespace taraxa::final_chain
\ No newline at end of file
@@ -23,6 +23,7 @@ FinalChain::FinalChain(const std::shared_ptr<DbStorage>& db, const taraxa::FullN
           config.genesis.pbft.committee_size, config.genesis.state.hardforks, db_,
           [this](EthBlockNumber n) { return dposEligibleTotalVoteCount(n); },
           state_api_.get_last_committed_state_descriptor().blk_num),
+      kPrefetchThreads(config.final_chain_prefetch_threads),
       block_headers_cache_(config.final_chain_cache_in_blocks, [this](uint64_t blk) { return getBlockHeader(blk); }),
       block_hashes_cache_(config.final_chain_cache_in_blocks, [this](uint64_t blk) { return getBlockHash(blk); }),
       transactions_cache_(config.final_chain_cache_in_blocks, [this](uint64_t blk) { return getTransactions(blk); }),
@@ -40,6 +41,9 @@ FinalChain::FinalChain(const std::shared_ptr<DbStorage>& db, const taraxa::FullN
           [this](uint64_t blk, const addr_t& addr) { return state_api_.dpos_is_eligible(blk, addr); }),
       kConfig(config) {
   LOG_OBJECTS_CREATE("EXECUTOR");
+  if (kPrefetchThreads) {
+    prefetch_pool_ = std::make_unique<boost::asio::thread_pool>(kPrefetchThreads);
+  }
   num_executed_dag_blk_ = db_->getStatusField(taraxa::StatusDbField::ExecutedBlkCount);
   num_executed_trx_ = db_->getStatusField(taraxa::StatusDbField::ExecutedTrxCount);
   auto state_db_descriptor = state_api_.get_last_committed_state_descriptor();
@@ -84,6 +88,7 @@ FinalChain::FinalChain(const std::shared_ptr<DbStorage>& db, const taraxa::FullN
       block_headers_cache_.get(num);
     }
   }
+  initLogIndex();
 
   delegation_delay_ = config.genesis.state.dpos.delegation_delay;
   const auto kPruneBlocksToKeep = kDagExpiryLevelLimit + kMaxLevelsPerPeriod + 1;
@@ -95,10 +100,23 @@ FinalChain::FinalChain(const std::shared_ptr<DbStorage>& db, const taraxa::FullN
   }
 }
 
-void FinalChain::stop() { executor_thread_.join(); }
+void FinalChain::stop() {
+  if (log_index_rebuild_thread_) {
+    log_index_rebuild_stopped_ = true;
+    log_index_rebuild_thread_->join();
+  }
+  if (prefetch_pool_) {
+    prefetch_pool_->stop();
+    prefetch_pool_->join();
+  }
+  executor_thread_.join();
+}
 
 std::future<std::shared_ptr<const FinalizationResult>> FinalChain::finalize(
     PeriodData&& new_blk, std::vector<h256>&& finalized_dag_blk_hashes, std::shared_ptr<DagBlock>&& anchor) {
+  if (prefetch_pool_) {
+    prefetchState(new_blk);
+  }
   auto p = std::make_shared<std::promise<std::shared_ptr<const FinalizationResult>>>();
   boost::asio::post(executor_thread_, [this, new_blk = std::move(new_blk),
                                        finalized_dag_blk_hashes = std::move(finalized_dag_blk_hashes),
@@ -109,6 +127,49 @@ std::future<std::shared_ptr<const FinalizationResult>> FinalChain::finalize(
   return p->get_future();
 }
 
+void FinalChain::prefetchState(const PeriodData& new_blk) {
+  std::unordered_set<addr_t> senders, receivers;
+  for (const auto& trx : new_blk.transactions) {
+    senders.insert(trx->getSender());
+    if (const auto& receiver = trx->getReceiver()) {
+      receivers.insert(*receiver);
+    }
+  }
+  if (senders.empty()) {
+    return;
+  }
+
+  // Values are not used, reads only bring trie nodes into state db caches. Latest committed state is read as state of
+  // the block parent may not be committed yet
+  const EthBlockNumber blk_num = last_block_number_;
+  auto addrs = std::make_shared<std::vector<std::pair<addr_t, bool>>>();
+  addrs->reserve(senders.size() + receivers.size());
+  for (const auto& addr : senders) {
+    addrs->emplace_back(addr, receivers.erase(addr) > 0);
+  }
+  for (const auto& addr : receivers) {
+    addrs->emplace_back(addr, true);
+  }
+
+  const auto chunk_size = (addrs->size() + kPrefetchThreads - 1) / kPrefetchThreads;
+  for (size_t begin = 0; begin < addrs->size(); begin += chunk_size) {
+    const auto end = std::min(begin + chunk_size, addrs->size());
+    boost::asio::post(*prefetch_pool_, [this, addrs, begin, end, blk_num] {
+      try {
+        for (auto i = begin; i < end; ++i) {
+          const auto& [addr, is_receiver] = (*addrs)[i];
+          const auto account = state_api_.get_account(blk_num, addr);
+          if (is_receiver && account && account->code_size) {
+            state_api_.get_code_by_address(blk_num, addr);
+          }
+        }
+      } catch (const std::exception& e) {
+        LOG(log_dg_) << "State prefetch of block " << blk_num << " stopped: " << e.what();
+      }
+    });
+  }
+}
+
 EthBlockNumber FinalChain::delegationDelay() const { return delegation_delay_; }
 
 SharedTransaction FinalChain::makeBridgeFinalizationTransaction() {
@@ -179,29 +240,15 @@ std::shared_ptr<const FinalizationResult> FinalChain::finalize_(PeriodData&& new
   std::vector<state_api::EVMTransaction> evm_trxs;
   appendEvmTransactions(evm_trxs, all_transactions);
 
-  const auto& [exec_results] = state_api_.execute_transactions(
-      {new_blk.pbft_blk->getBeneficiary(), kBlockGasLimit, new_blk.pbft_blk->getTimestamp(), BlockHeader::difficulty()},
-      evm_trxs);
   TransactionReceipts receipts;
-  receipts.reserve(exec_results.size());
+  state_api_.execute_transactions(
+      {new_blk.pbft_blk->getBeneficiary(), kBlockGasLimit, new_blk.pbft_blk->getTimestamp(), BlockHeader::difficulty()},
+      evm_trxs, receipts);
+
   std::vector<gas_t> transactions_gas_used;
-  transactions_gas_used.reserve(exec_results.size());
-
-  gas_t cumulative_gas_used = 0;
-  for (const auto& r : exec_results) {
-    LogEntries logs;
-    logs.reserve(r.logs.size());
-    std::transform(r.logs.cbegin(), r.logs.cend(), std::back_inserter(logs), [](const auto& l) {
-      return LogEntry{l.address, l.topics, l.data};
-    });
+  transactions_gas_used.reserve(receipts.size());
+  for (const auto& r : receipts) {
     transactions_gas_used.push_back(r.gas_used);
-    receipts.emplace_back(TransactionReceipt{
-        r.code_err.empty() && r.consensus_err.empty(),
-        r.gas_used,
-        cumulative_gas_used += r.gas_used,
-        std::move(logs),
-        r.new_contract_addr ? std::optional(r.new_contract_addr) : std::nullopt,
-    });
   }
 
   auto rewards_stats = rewards_.processStats(new_blk, transactions_gas_used, batch);
@@ -266,6 +313,7 @@ std::shared_ptr<const FinalizationResult> FinalChain::finalize_(PeriodData&& new
   // Creates snapshot if needed
   if (db_->createSnapshot(blk_header->number)) {
     state_api_.create_snapshot(blk_header->number);
+    db_->scheduleSnapshotBackup(blk_header->number);
   }
 
   return result;
@@ -281,17 +329,21 @@ void FinalChain::prune(EthBlockNumber blk_n) {
       state_root_to_keep.push_back(block_to_keep->state_root);
       block_to_keep = getBlockHeader(block_to_keep->number + 1);
     }
+    // Headers are removed in batches, pruned columns are compacted by rocksdb when their sst files accumulate
+    // enough tombstones
+    const uint32_t max_batch_delete = 10000;
+    auto batch = db_->createWriteBatch();
     auto block_to_prune = getBlockHeader(last_block_to_keep->number - 1);
     while (block_to_prune && block_to_prune->number > 0) {
-      db_->remove(DbStorage::Columns::final_chain_blk_by_number, block_to_prune->number);
-      db_->remove(DbStorage::Columns::final_chain_blk_hash_by_number, block_to_prune->number);
-      db_->remove(DbStorage::Columns::final_chain_blk_number_by_hash, block_to_prune->hash);
+      db_->remove(batch, DbStorage::Columns::final_chain_blk_by_number, block_to_prune->number);
+      db_->remove(batch, DbStorage::Columns::final_chain_blk_hash_by_number, block_to_prune->number);
+      db_->remove(batch, DbStorage::Columns::final_chain_blk_number_by_hash, block_to_prune->hash);
+      if (block_to_prune->number % max_batch_delete == 0) {
+        db_->commitWriteBatch(batch);
+      }
       block_to_prune = getBlockHeader(block_to_prune->number - 1);
     }
-
-    db_->compactColumn(DbStorage::Columns::final_chain_blk_by_number);
-    db_->compactColumn(DbStorage::Columns::final_chain_blk_hash_by_number);
-    db_->compactColumn(DbStorage::Columns::final_chain_blk_number_by_hash);
+    db_->commitWriteBatch(batch);
 
     state_api_.prune(state_root_to_keep, last_block_to_keep->number);
   }
@@ -322,6 +374,7 @@ std::shared_ptr<BlockHeader> FinalChain::appendBlock(Batch& batch, std::shared_p
                                                      const TransactionReceipts& receipts) {
   dev::BytesMap trxs_trie, receipts_trie;
   dev::RLPStream rlp_strm;
+  std::vector<bytes> receipts_rlp;
   size_t trx_idx = 0;
   for (; trx_idx < transactions.size(); ++trx_idx) {
     const auto& trx = transactions[trx_idx];
@@ -330,10 +383,18 @@ std::shared_ptr<BlockHeader> FinalChain::appendBlock(Batch& batch, std::shared_p
 
     const auto& receipt = receipts[trx_idx];
     receipts_trie[i_rlp] = util::rlp_enc(rlp_strm, receipt);
-    db_->insert(batch, DbStorage::Columns::final_chain_receipt_by_trx_hash, trx->getHash(), rlp_strm.out());
+    if (kConfig.db_config.receipts_by_block) {
+      receipts_rlp.push_back(rlp_strm.out());
+    } else {
+      db_->insert(batch, DbStorage::Columns::final_chain_receipt_by_trx_hash, trx->getHash(), rlp_strm.out());
+    }
 
     header->log_bloom |= receipt.bloom();
   }
+  if (!receipts_rlp.empty()) {
+    db_->insert(batch, DbStorage::Columns::final_chain_receipts_by_block, header->number,
+                encodeReceiptsBlob(receipts_rlp));
+  }
 
   header->transactions_root = hash256(trxs_trie);
   header->receipts_root = hash256(receipts_trie);
@@ -351,6 +412,9 @@ std::shared_ptr<BlockHeader> FinalChain::appendBlock(Batch& batch, std::shared_p
     db_->insert(batch, DbStorage::Columns::final_chain_log_blooms_index, chunk_id,
                 util::rlp_enc(rlp_strm, chunk_to_alter));
   }
+  if (log_index_enabled_) {
+    addLogIndexToBatch(batch, header->number, receipts);
+  }
   db_->insert(batch, DbStorage::Columns::final_chain_blk_hash_by_number, header->number, header->hash);
   db_->insert(batch, DbStorage::Columns::final_chain_blk_number_by_hash, header->hash, header->number);
   db_->insert(batch, DbStorage::Columns::final_chain_meta, DBMetaKeys::LAST_NUMBER, header->number);
@@ -381,14 +445,96 @@ std::optional<TransactionLocation> FinalChain::transactionLocation(const h256& t
 
 std::optional<TransactionReceipt> FinalChain::transactionReceipt(const h256& trx_h) const {
   auto raw = db_->lookup(trx_h, DbStorage::Columns::final_chain_receipt_by_trx_hash);
-  if (raw.empty()) {
+  if (!raw.empty()) {
+    TransactionReceipt ret;
+    ret.rlp(dev::RLP(raw));
+    return ret;
+  }
+  // Receipt could be stored in block receipts blob
+  const auto location = db_->getTransactionLocation(trx_h);
+  if (!location) {
+    return {};
+  }
+  const auto blob = db_->lookupPinned(location->period, DbStorage::Columns::final_chain_receipts_by_block);
+  if (blob.empty()) {
     return {};
   }
-  TransactionReceipt ret;
-  ret.rlp(dev::RLP(raw));
+  return decodeReceiptFromBlob(blob.ref(), receiptIndex(*location));
+}
+
+std::vector<std::optional<TransactionReceipt>> FinalChain::transactionReceipts(
+    const std::vector<h256>& trx_hashes) const {
+  std::vector<std::optional<TransactionReceipt>> ret(trx_hashes.size());
+  const auto raw = db_->multiLookup(trx_hashes, DbStorage::Columns::final_chain_receipt_by_trx_hash);
+  std::vector<size_t> missing_idx;
+  std::vector<h256> missing_hashes;
+  for (size_t i = 0; i < trx_hashes.size(); ++i) {
+    if (raw[i].empty()) {
+      missing_idx.push_back(i);
+      missing_hashes.push_back(trx_hashes[i]);
+      continue;
+    }
+    ret[i].emplace().rlp(raw[i].rlp());
+  }
+  if (missing_hashes.empty()) {
+    return ret;
+  }
+
+  // Receipts missing by hash could be stored in block receipts blobs, each blob is read once
+  const auto locations = db_->getTransactionLocations(missing_hashes);
+  std::map<EthBlockNumber, std::vector<std::pair<size_t, uint32_t>>> receipts_by_block;
+  for (size_t i = 0; i < missing_hashes.size(); ++i) {
+    if (locations[i]) {
+      receipts_by_block[locations[i]->period].emplace_back(missing_idx[i], receiptIndex(*locations[i]));
+    }
+  }
+  if (receipts_by_block.empty()) {
+    return ret;
+  }
+  std::vector<EthBlockNumber> blocks;
+  blocks.reserve(receipts_by_block.size());
+  for (const auto& [blk_n, _] : receipts_by_block) {
+    blocks.push_back(blk_n);
+  }
+  const auto blobs = db_->multiLookup(blocks, DbStorage::Columns::final_chain_receipts_by_block);
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    if (blobs[i].empty()) {
+      continue;
+    }
+    for (const auto& [ret_idx, receipt_idx] : receipts_by_block[blocks[i]]) {
+      ret[ret_idx] = decodeReceiptFromBlob(blobs[i].ref(), receipt_idx);
+    }
+  }
   return ret;
 }
 
+TransactionReceipts FinalChain::blockReceipts(std::optional<EthBlockNumber> n) const {
+  const auto blk_n = lastIfAbsent(n);
+  if (const auto blob = db_->lookupPinned(blk_n, DbStorage::Columns::final_chain_receipts_by_block); !blob.empty()) {
+    return decodeReceiptsBlob(blob.ref());
+  }
+
+  auto hashes = *getTransactionHashes(blk_n);
+  const auto system_trx_hashes = db_->getPeriodSystemTransactionsHashes(blk_n);
+  hashes.insert(hashes.end(), system_trx_hashes.begin(), system_trx_hashes.end());
+  TransactionReceipts ret;
+  ret.reserve(hashes.size());
+  for (auto& receipt : transactionReceipts(hashes)) {
+    // Receipts of pruned blocks are missing
+    if (!receipt) {
+      return {};
+    }
+    ret.push_back(std::move(*receipt));
+  }
+  return ret;
+}
+
+uint32_t FinalChain::receiptIndex(const TransactionLocation& location) {
+  // System transactions locations are counted from block transactions count + 1, while their receipts follow block
+  // transactions receipts
+  return location.is_system ? location.position - 1 : location.position;
+}
+
 uint64_t FinalChain::transactionCount(std::optional<EthBlockNumber> n) const {
   return db_->getTransactionCount(lastIfAbsent(n));
 }
@@ -403,12 +549,41 @@ const SharedTransactions FinalChain::transactions(std::optional<EthBlockNumber>
 
 std::vector<EthBlockNumber> FinalChain::withBlockBloom(const LogBloom& b, EthBlockNumber from,
                                                        EthBlockNumber to) const {
+  return withBlockBloom(LogBlooms{b}, from, to);
+}
+
+std::vector<EthBlockNumber> FinalChain::withBlockBloom(const LogBlooms& blooms, EthBlockNumber from,
+                                                       EthBlockNumber to) const {
+  if (blooms.empty() || from > to) {
+    return {};
+  }
+  // Number of blocks covered by single top level chunk
+  const auto top_span = int_pow(c_bloomIndexSize, c_bloomIndexLevels);
+  const auto chunks_count = to / top_span - from / top_span + 1;
+  const auto threads = std::min<uint64_t>(kBloomQueryThreads, chunks_count / kBloomQueryChunksPerThread);
+  if (threads < 2) {
+    return matchBlockBlooms(blooms, from, to);
+  }
+
+  // Split range on top level chunks boundaries, so sub-ranges don't read the same chunks
+  const auto chunks_per_thread = (chunks_count + threads - 1) / threads;
+  std::vector<std::future<std::vector<EthBlockNumber>>> sub_ranges;
+  for (auto chunk = from / top_span; chunk <= to / top_span; chunk += chunks_per_thread) {
+    const auto sub_from = std::max(from, chunk * top_span);
+    const auto sub_to = std::min(to, (chunk + chunks_per_thread) * top_span - 1);
+    auto task = std::make_shared<std::packaged_task<std::vector<EthBlockNumber>()>>(
+        [this, &blooms, sub_from, sub_to] { return matchBlockBlooms(blooms, sub_from, sub_to); });
+    sub_ranges.emplace_back(task->get_future());
+    boost::asio::post(bloom_query_pool_, [task] { (*task)(); });
+  }
+
+  // Sub-ranges reference blooms and this, so all of them are finished before an error of any is rethrown
+  for (const auto& sub_range : sub_ranges) {
+    sub_range.wait();
+  }
   std::vector<EthBlockNumber> ret;
-  // start from the top-level
-  auto u = int_pow(c_bloomIndexSize, c_bloomIndexLevels);
-  // run through each of the top-level blocks
-  for (EthBlockNumber index = from / u; index <= (to + u - 1) / u; ++index) {
-    dev::operator+=(ret, withBlockBloom(b, from, to, c_bloomIndexLevels - 1, index));
+  for (auto& sub_range : sub_ranges) {
+    dev::operator+=(ret, sub_range.get());
   }
   return ret;
 }
@@ -418,6 +593,14 @@ std::optional<state_api::Account> FinalChain::getAccount(const addr_t& addr,
   return accounts_cache_.get(lastIfAbsent(blk_n), addr);
 }
 
+std::vector<std::optional<state_api::Account>> FinalChain::getAccounts(const std::vector<addr_t>& addrs,
+                                                                       std::optional<EthBlockNumber> blk_n) const {
+  const auto accounts = accounts_cache_.getMany(
+      lastIfAbsent(blk_n), addrs,
+      [this](uint64_t blk, const std::vector<addr_t>& missing) { return state_api_.get_accounts(blk, missing); });
+  return {accounts.begin(), accounts.end()};
+}
+
 void FinalChain::updateStateConfig(const state_api::Config& new_config) {
   delegation_delay_ = new_config.dpos.delegation_delay;
   state_api_.update_state_config(new_config);
@@ -427,6 +610,11 @@ h256 FinalChain::getAccountStorage(const addr_t& addr, const u256& key, std::opt
   return state_api_.get_account_storage(lastIfAbsent(blk_n), addr, key);
 }
 
+std::vector<h256> FinalChain::getAccountStorages(const addr_t& addr, const std::vector<u256>& keys,
+                                                 std::optional<EthBlockNumber> blk_n) const {
+  return state_api_.get_account_storages(lastIfAbsent(blk_n), addr, keys);
+}
+
 bytes FinalChain::getCode(const addr_t& addr, std::optional<EthBlockNumber> blk_n) const {
   return state_api_.get_code_by_address(lastIfAbsent(blk_n), addr);
 }
@@ -472,6 +660,13 @@ uint64_t FinalChain::dposEligibleVoteCount(EthBlockNumber blk_num, const addr_t&
   return dpos_vote_count_cache_.get(blk_num, addr);
 }
 
+std::vector<uint64_t> FinalChain::dposEligibleVoteCounts(EthBlockNumber blk_num,
+                                                        const std::vector<addr_t>& addrs) const {
+  return dpos_vote_count_cache_.getMany(blk_num, addrs, [this](uint64_t blk, const std::vector<addr_t>& missing) {
+    return state_api_.dpos_eligible_vote_counts(blk, missing);
+  });
+}
+
 bool FinalChain::dposIsEligible(EthBlockNumber blk_num, const addr_t& addr) const {
   return dpos_is_eligible_cache_.get(blk_num, addr);
 }
@@ -626,27 +821,190 @@ BlocksBlooms FinalChain::blockBlooms(const h256& chunk_id) const {
   return {};
 }
 
-h256 FinalChain::blockBloomsChunkId(EthBlockNumber level, EthBlockNumber index) { return h256(index * 0xff + level); }
+void FinalChain::initLogIndex() {
+  const auto log_index_from =
+      db_->lookup_int<EthBlockNumber>(DBMetaKeys::LOG_INDEX_FROM, DbStorage::Columns::final_chain_meta);
+  if (!kConfig.db_config.log_index) {
+    // Index would miss blocks finalized while it is disabled, so it can't be used once enabled again
+    if (log_index_from) {
+      LOG(log_nf_) << "Log index disabled, removing it";
+      db_->remove(DbStorage::Columns::final_chain_meta, DBMetaKeys::LOG_INDEX_FROM);
+      db_->deleteColumnData(DbStorage::Columns::final_chain_log_index);
+    }
+    return;
+  }
 
-std::vector<EthBlockNumber> FinalChain::withBlockBloom(const LogBloom& b, EthBlockNumber from, EthBlockNumber to,
-                                                       EthBlockNumber level, EthBlockNumber index) const {
-  std::vector<EthBlockNumber> ret;
-  auto uCourse = int_pow(c_bloomIndexSize, level + 1);
-  auto uFine = int_pow(c_bloomIndexSize, level);
-  auto obegin = index == from / uCourse ? from / uFine % c_bloomIndexSize : 0;
-  auto oend = index == to / uCourse ? (to / uFine) % c_bloomIndexSize + 1 : c_bloomIndexSize;
-  auto bb = blockBlooms(blockBloomsChunkId(level, index));
-  for (auto o = obegin; o < oend; ++o) {
-    if (bb[o].contains(b)) {
-      // This level has something like what we want.
-      if (level > 0) {
-        dev::operator+=(ret, withBlockBloom(b, from, to, level - 1, o + index * c_bloomIndexSize));
-      } else {
-        ret.push_back(o + index * c_bloomIndexSize);
+  log_index_enabled_ = true;
+  if (kConfig.db_config.rebuild_log_index) {
+    db_->remove(DbStorage::Columns::final_chain_meta, DBMetaKeys::LOG_INDEX_FROM);
+    db_->deleteColumnData(DbStorage::Columns::final_chain_log_index);
+    // New blocks are indexed by finalization, rebuild indexes the older ones in background. Log queries use blooms
+    // until it is complete
+    log_index_rebuild_thread_ = std::make_unique<boost::asio::thread_pool>(1);
+    boost::asio::post(*log_index_rebuild_thread_, [this, last_block_number = last_block_number_.load()] {
+      rebuildLogIndex(last_block_number);
+    });
+    return;
+  }
+  if (log_index_from) {
+    log_index_from_ = *log_index_from;
+    return;
+  }
+  // Index is built only for new blocks, older ones are indexed by rebuild
+  log_index_from_ = last_block_number_ + 1;
+  db_->insert(DbStorage::Columns::final_chain_meta, DBMetaKeys::LOG_INDEX_FROM, log_index_from_.load());
+  LOG(log_nf_) << "Log index enabled from block " << log_index_from_.load();
+}
+
+void FinalChain::rebuildLogIndex(EthBlockNumber last_block_number) {
+  LOG(log_si_) << "Rebuilding log index up to block " << last_block_number << " in background";
+  const uint32_t max_batch_blocks = 10000;
+  auto batch = db_->createWriteBatch();
+  for (EthBlockNumber blk_n = 1; blk_n <= last_block_number; ++blk_n) {
+    if (log_index_rebuild_stopped_) {
+      LOG(log_nf_) << "Rebuilding log index stopped at block " << blk_n << ", it has to be rebuilt again";
+      return;
+    }
+    addLogIndexToBatch(batch, blk_n, blockReceipts(blk_n));
+
+    if (blk_n % max_batch_blocks == 0) {
+      db_->commitWriteBatch(batch);
+      LOG(log_nf_) << "Log index rebuilt up to block " << blk_n;
+    }
+  }
+  db_->insert(batch, DbStorage::Columns::final_chain_meta, DBMetaKeys::LOG_INDEX_FROM, EthBlockNumber(0));
+  db_->commitWriteBatch(batch);
+  log_index_from_ = 0;
+  LOG(log_si_) << "Rebuilding log index complete";
+}
+
+void FinalChain::addLogIndexToBatch(Batch& batch, EthBlockNumber blk_n, const TransactionReceipts& receipts) {
+  AddressSet addresses;
+  std::unordered_set<h256> topics;
+  for (const auto& receipt : receipts) {
+    for (const auto& log : receipt.logs) {
+      addresses.insert(log.address);
+      if (!log.topics.empty()) {
+        topics.insert(log.topics.front());
       }
     }
   }
+  if (addresses.empty()) {
+    return;
+  }
+
+  dev::RLPStream block_keys(addresses.size() + topics.size());
+  const auto add_key = [&](uint8_t kind, dev::bytesConstRef id) {
+    auto key = logIndexKey(kind, id, blk_n);
+    db_->insert(batch, DbStorage::Columns::final_chain_log_index, key, dev::bytes());
+    block_keys << key;
+  };
+  for (const auto& address : addresses) {
+    add_key(kLogIndexAddress, address.ref());
+  }
+  for (const auto& topic : topics) {
+    add_key(kLogIndexTopic, topic.ref());
+  }
+  db_->insert(batch, DbStorage::Columns::final_chain_log_index, logIndexKey(kLogIndexBlock, {}, blk_n),
+              block_keys.out());
+}
+
+void FinalChain::logIndexBlocks(uint8_t kind, dev::bytesConstRef id, EthBlockNumber from, EthBlockNumber to,
+                                std::set<EthBlockNumber>& blocks) const {
+  const auto start = logIndexKey(kind, id, from);
+  const auto prefix = DbStorage::toSlice(dev::bytesConstRef(&start).cropped(0, start.size() - sizeof(EthBlockNumber)));
+  auto it = db_->getColumnIterator(DbStorage::Columns::final_chain_log_index);
+  for (it->Seek(DbStorage::toSlice(start)); it->Valid() && it->key().starts_with(prefix); it->Next()) {
+    EthBlockNumber blk_n = 0;
+    for (size_t i = prefix.size(); i < it->key().size(); ++i) {
+      blk_n = (blk_n << 8) | static_cast<uint8_t>(it->key()[i]);
+    }
+    if (blk_n > to) {
+      break;
+    }
+    blocks.insert(blk_n);
+  }
+}
+
+std::optional<std::vector<EthBlockNumber>> FinalChain::withLogIndex(const AddressSet& addresses,
+                                                                    const std::unordered_set<h256>& topics,
+                                                                    EthBlockNumber from, EthBlockNumber to) const {
+  if (from < log_index_from_ || (addresses.empty() && topics.empty())) {
+    return {};
+  }
+
+  std::set<EthBlockNumber> address_blocks, topic_blocks;
+  for (const auto& address : addresses) {
+    logIndexBlocks(kLogIndexAddress, address.ref(), from, to, address_blocks);
+  }
+  for (const auto& topic : topics) {
+    logIndexBlocks(kLogIndexTopic, topic.ref(), from, to, topic_blocks);
+  }
+
+  std::vector<EthBlockNumber> ret;
+  if (addresses.empty()) {
+    ret.assign(topic_blocks.begin(), topic_blocks.end());
+  } else if (topics.empty()) {
+    ret.assign(address_blocks.begin(), address_blocks.end());
+  } else {
+    std::set_intersection(address_blocks.begin(), address_blocks.end(), topic_blocks.begin(), topic_blocks.end(),
+                          std::back_inserter(ret));
+  }
   return ret;
 }
 
+std::vector<std::pair<std::string, CacheStats>> FinalChain::cachesStats() const {
+  return {
+      {"block_headers", block_headers_cache_.stats()},
+      {"block_hashes", block_hashes_cache_.stats()},
+      {"transactions", transactions_cache_.stats()},
+      {"transaction_hashes", transaction_hashes_cache_.stats()},
+      {"accounts", accounts_cache_.stats()},
+      {"total_vote_count", total_vote_count_cache_.stats()},
+      {"dpos_vote_count", dpos_vote_count_cache_.stats()},
+      {"dpos_is_eligible", dpos_is_eligible_cache_.stats()},
+  };
+}
+
+std::vector<EthBlockNumber> FinalChain::matchBlockBlooms(const LogBlooms& blooms, EthBlockNumber from,
+                                                         EthBlockNumber to) const {
+  // Index is searched level by level from the top, chunks of each level are read with single batch
+  const auto top_span = int_pow(c_bloomIndexSize, c_bloomIndexLevels);
+  std::vector<EthBlockNumber> indexes;
+  for (auto index = from / top_span; index <= to / top_span; ++index) {
+    indexes.push_back(index);
+  }
+
+  for (int64_t level = c_bloomIndexLevels - 1; level >= 0; --level) {
+    // Number of blocks covered by single bloom of chunk on this level
+    const auto span = int_pow(c_bloomIndexSize, level);
+    std::vector<h256> chunk_ids;
+    chunk_ids.reserve(indexes.size());
+    std::transform(indexes.begin(), indexes.end(), std::back_inserter(chunk_ids),
+                   [level](auto index) { return blockBloomsChunkId(level, index); });
+    const auto chunks = db_->multiLookup(chunk_ids, DbStorage::Columns::final_chain_log_blooms_index);
+
+    std::vector<EthBlockNumber> matching;
+    for (size_t i = 0; i < indexes.size(); ++i) {
+      if (chunks[i].empty()) {
+        continue;
+      }
+      const auto chunk = chunks[i].rlp().toArray<LogBloom, c_bloomIndexSize>();
+      for (EthBlockNumber o = 0; o < c_bloomIndexSize; ++o) {
+        // Index on the lower level, on the lowest level it is block number
+        const auto sub_index = indexes[i] * c_bloomIndexSize + o;
+        if ((sub_index + 1) * span <= from || sub_index * span > to) {
+          continue;
+        }
+        if (std::any_of(blooms.begin(), blooms.end(),
+                        [&](const auto& b) { return bloomContains(chunk[o], b); })) {
+          matching.push_back(sub_index);
+        }
+      }
+    }
+    indexes = std::move(matching);
+  }
+  return indexes;
+}
+
 }  // namespace taraxa::final_chain
\ No newline at end of file
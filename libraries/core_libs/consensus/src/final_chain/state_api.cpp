@@ -30,6 +30,31 @@ void to_u256(taraxa_evm_Bytes b, u256& result) { result = fromBigEndian<u256>(ma
 
 void to_h256(taraxa_evm_Bytes b, h256& result) { result = h256(fromBigEndian<u256>(map_bytes(b))); }
 
+void decode_receipts(bytesConstRef execution_results_rlp, final_chain::TransactionReceipts& receipts) {
+  // Encoding is list with single item, list of ExecutionResult
+  const auto execution_results = dev::RLP(execution_results_rlp, 0)[0];
+  receipts.reserve(receipts.size() + execution_results.itemCount());
+  gas_t cumulative_gas_used = 0;
+  for (const auto r : execution_results) {
+    // ExecutionResult fields: code_retval, new_contract_addr, logs, gas_used, code_err, consensus_err
+    auto& receipt = receipts.emplace_back();
+    util::rlp(r[3], receipt.gas_used);
+    receipt.cumulative_gas_used = cumulative_gas_used += receipt.gas_used;
+    receipt.status_code = r[4].isEmpty() && r[5].isEmpty();
+    addr_t new_contract_addr;
+    util::rlp(r[1], new_contract_addr);
+    if (new_contract_addr) {
+      receipt.new_contract_address = new_contract_addr;
+    }
+    // LogRecord and LogEntry have the same encoding
+    util::rlp(r[2], receipt.logs);
+  }
+}
+
+void to_receipts(taraxa_evm_Bytes b, final_chain::TransactionReceipts& receipts) {
+  decode_receipts(map_bytes(b), receipts);
+}
+
 template <typename Result, void (*decode)(taraxa_evm_Bytes, Result&)>
 taraxa_evm_BytesCallback decoder_cb_c(Result& res) {
   return {
@@ -80,9 +105,9 @@ template <typename Result,                            //
           void (*fn)(taraxa_evm_state_API_ptr, taraxa_evm_Bytes, taraxa_evm_BytesCallback,
                      taraxa_evm_BytesCallback),  //
           typename... Params>
-void c_method_args_rlp(taraxa_evm_state_API_ptr this_c, dev::RLPStream& encoding, Result& ret, const Params&... args) {
+void c_method_args_rlp(taraxa_evm_state_API_ptr this_c, dev::RLPStream& encoding, ErrorHandler& err_h, Result& ret,
+                       const Params&... args) {
   util::rlp_tuple(encoding, args...);
-  ErrorHandler err_h;
   fn(this_c, map_bytes(encoding.out()), decoder_cb_c<Result, decode>(ret), err_h.cgo_part_);
   err_h.check();
 }
@@ -94,8 +119,9 @@ template <typename Result,                            //
           typename... Params>
 Result c_method_args_rlp(taraxa_evm_state_API_ptr this_c, const Params&... args) {
   dev::RLPStream encoding;
+  ErrorHandler err_h;
   Result ret;
-  c_method_args_rlp<Result, decode, fn, Params...>(this_c, encoding, ret, args...);
+  c_method_args_rlp<Result, decode, fn, Params...>(this_c, encoding, err_h, ret, args...);
   return ret;
 }
 
@@ -121,7 +147,6 @@ StateAPI::StateAPI(decltype(get_blk_hash_) get_blk_hash, const Config& state_con
           },
       },
       db_path_(opts_db.db_path) {
-  result_buf_execution_result_.execution_results.reserve(opts.expected_max_trx_per_block);
   rlp_enc_execution_result_.reserve(opts.expected_max_trx_per_block * 1024, opts.expected_max_trx_per_block * 128);
   rlp_enc_rewards_distribution_.reserve(opts.expected_max_trx_per_block * 1024, opts.expected_max_trx_per_block * 128);
   dev::RLPStream encoding;
@@ -154,6 +179,35 @@ h256 StateAPI::get_account_storage(EthBlockNumber blk_num, const addr_t& addr, c
   return c_method_args_rlp<h256, to_h256, taraxa_evm_state_api_get_account_storage>(this_c_, blk_num, addr, key);
 }
 
+std::vector<std::optional<Account>> StateAPI::get_accounts(EthBlockNumber blk_num,
+                                                           const std::vector<addr_t>& addrs) const {
+  std::vector<std::optional<Account>> ret(addrs.size());
+  dev::RLPStream encoding;
+  encoding.reserve(sizeof(EthBlockNumber) + sizeof(addr_t) + 8, 1);
+  // Handler throws on first error, so it has no error set while it is reused
+  ErrorHandler err_h;
+  for (size_t i = 0; i < addrs.size(); ++i) {
+    encoding.clear();
+    c_method_args_rlp<std::optional<Account>, from_rlp, taraxa_evm_state_api_get_account>(this_c_, encoding, err_h,
+                                                                                           ret[i], blk_num, addrs[i]);
+  }
+  return ret;
+}
+
+std::vector<h256> StateAPI::get_account_storages(EthBlockNumber blk_num, const addr_t& addr,
+                                                 const std::vector<u256>& keys) const {
+  std::vector<h256> ret(keys.size());
+  dev::RLPStream encoding;
+  encoding.reserve(sizeof(EthBlockNumber) + sizeof(addr_t) + sizeof(u256) + 8, 1);
+  ErrorHandler err_h;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    encoding.clear();
+    c_method_args_rlp<h256, to_h256, taraxa_evm_state_api_get_account_storage>(this_c_, encoding, err_h, ret[i],
+                                                                               blk_num, addr, keys[i]);
+  }
+  return ret;
+}
+
 bytes StateAPI::get_code_by_address(EthBlockNumber blk_num, const addr_t& addr) const {
   return c_method_args_rlp<bytes, to_bytes, taraxa_evm_state_api_get_code_by_address>(this_c_, blk_num, addr);
 }
@@ -179,13 +233,11 @@ StateDescriptor StateAPI::get_last_committed_state_descriptor() const {
   return ret;
 }
 
-const TransactionsExecutionResult& StateAPI::execute_transactions(const EVMBlock& block,
-                                                                  const std::vector<EVMTransaction>& transactions) {
-  result_buf_execution_result_.execution_results.clear();
+void StateAPI::execute_transactions(const EVMBlock& block, const std::vector<EVMTransaction>& transactions,
+                                    final_chain::TransactionReceipts& receipts) {
   rlp_enc_execution_result_.clear();
-  c_method_args_rlp<TransactionsExecutionResult, from_rlp, taraxa_evm_state_api_execute_transactions>(
-      this_c_, rlp_enc_execution_result_, result_buf_execution_result_, block, transactions);
-  return result_buf_execution_result_;
+  c_method_args_rlp<final_chain::TransactionReceipts, to_receipts, taraxa_evm_state_api_execute_transactions>(
+      this_c_, rlp_enc_execution_result_, receipts, block, transactions);
 }
 
 const RewardsDistributionResult& StateAPI::distribute_rewards(const std::vector<rewards::BlockStats>& rewards_stats) {
@@ -233,6 +285,23 @@ uint64_t StateAPI::dpos_eligible_vote_count(EthBlockNumber blk_num, const addr_t
   return ret;
 }
 
+std::vector<uint64_t> StateAPI::dpos_eligible_vote_counts(EthBlockNumber blk_num,
+                                                          const std::vector<addr_t>& addrs) const {
+  std::vector<uint64_t> ret;
+  ret.reserve(addrs.size());
+  dev::RLPStream encoding;
+  encoding.reserve(sizeof(EthBlockNumber) + sizeof(addr_t) + 8, 1);
+  ErrorHandler err_h;
+  for (const auto& addr : addrs) {
+    encoding.clear();
+    util::rlp_tuple(encoding, blk_num, addr);
+    ret.push_back(
+        taraxa_evm_state_api_dpos_get_eligible_vote_count(this_c_, map_bytes(encoding.out()), err_h.cgo_part_));
+    err_h.check();
+  }
+  return ret;
+}
+
 bool StateAPI::dpos_is_eligible(EthBlockNumber blk_num, const addr_t& addr) const {
   dev::RLPStream encoding;
   encoding.reserve(sizeof(EthBlockNumber) + sizeof(addr_t) + 8, 1);
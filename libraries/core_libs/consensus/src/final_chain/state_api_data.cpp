@@ -16,7 +16,6 @@ RLP_FIELDS_DEFINE(EVMTransaction, from, gas_price, to, nonce, value, gas, input)
 RLP_FIELDS_DEFINE(UncleBlock, number, author)
 RLP_FIELDS_DEFINE(LogRecord, address, topics, data)
 RLP_FIELDS_DEFINE(ExecutionResult, code_retval, new_contract_addr, logs, gas_used, code_err, consensus_err)
-RLP_FIELDS_DEFINE(TransactionsExecutionResult, execution_results)
 RLP_FIELDS_DEFINE(RewardsDistributionResult, state_root, total_reward)
 RLP_FIELDS_DEFINE(Account, nonce, balance, storage_root_hash, code_hash, code_size)
 RLP_FIELDS_DEFINE(StateDescriptor, blk_num, state_root)
@@ -68,6 +68,7 @@ PbftManager::PbftManager(const FullNodeConfig &conf, std::shared_ptr<DbStorage>
     }
 
     // We need this section because votes need to be verified for reward distribution
+    vote_mgr_->prefetchVotersVoteCounts(period_data->previous_block_cert_votes);
     for (const auto &v : period_data->previous_block_cert_votes) {
       vote_mgr_->validateVote(v);
     }
@@ -1999,6 +2000,7 @@ bool PbftManager::validatePbftBlockCertVotes(const std::shared_ptr<PbftBlock> pb
     return false;
   }
 
+  vote_mgr_->prefetchVotersVoteCounts(cert_votes);
   for (uint32_t vote_counter = 0; vote_counter < cert_votes.size(); vote_counter++) {
     const auto &v = cert_votes[vote_counter];
     // Any info is wrong that can determine the synced PBFT block comes from a malicious player
@@ -1,9 +1,11 @@
 #include "transaction/transaction_manager.hpp"
 
+#include <chrono>
 #include <string>
 #include <unordered_set>
 #include <utility>
 
+#include "common/util.hpp"
 #include "config/config.hpp"
 #include "logger/logger.hpp"
 #include "transaction/transaction.hpp"
@@ -14,13 +16,34 @@ TransactionManager::TransactionManager(const FullNodeConfig &conf, std::shared_p
     : kConf(conf),
       transactions_pool_(final_chain, kConf.transactions_pool_size),
       kDagBlockGasLimit(kConf.genesis.dag.gas_limit),
+      kSenderRecoveryThreads(kConf.transactions_sender_recovery_threads),
+      kGasEstimationThreads(kConf.transactions_gas_estimation_threads),
+      gas_estimation_cache_(kGasEstimationCacheBlocks),
       db_(std::move(db)),
       final_chain_(std::move(final_chain)) {
   LOG_OBJECTS_CREATE("TRXMGR");
+  if (kSenderRecoveryThreads) {
+    sender_recovery_pool_ = std::make_unique<boost::asio::thread_pool>(kSenderRecoveryThreads);
+  }
+  if (kGasEstimationThreads) {
+    gas_estimation_pool_ = std::make_unique<boost::asio::thread_pool>(kGasEstimationThreads);
+  }
   {
     std::unique_lock transactions_lock(transactions_mutex_);
     trx_count_ = db_->getStatusField(taraxa::StatusDbField::TrxCount);
   }
+  if (kConf.transactions_pool_journal) {
+    journal_worker_ = std::make_unique<util::ThreadPool>(1);
+    journal_worker_->post_loop({kJournalFlushPeriodMs}, [this] { flushPoolJournal(); });
+  }
+}
+
+TransactionManager::~TransactionManager() {
+  if (journal_worker_) {
+    journal_worker_->stop();
+    // Transactions inserted after the last periodic flush would be lost otherwise
+    flushPoolJournal();
+  }
 }
 
 uint64_t TransactionManager::estimateTransactionGas(std::shared_ptr<Transaction> trx,
@@ -28,22 +51,45 @@ uint64_t TransactionManager::estimateTransactionGas(std::shared_ptr<Transaction>
   if (trx->getGas() <= kEstimateGasLimit) {
     return trx->getGas();
   }
-  const auto &result = final_chain_->call(
-      state_api::EVMTransaction{
-          trx->getSender(),
-          trx->getGasPrice(),
-          trx->getReceiver(),
-          trx->getNonce(),
-          trx->getValue(),
-          kDagBlockGasLimit,
-          trx->getData(),
-      },
-      proposal_period);
-
-  if (!result.code_err.empty() || !result.consensus_err.empty()) {
-    return 0;
-  }
-  return result.gas_used;
+  const auto estimate = [&]() -> std::optional<uint64_t> {
+    const auto start = std::chrono::steady_clock::now();
+    const auto &result = final_chain_->call(
+        state_api::EVMTransaction{
+            trx->getSender(),
+            trx->getGasPrice(),
+            trx->getReceiver(),
+            trx->getNonce(),
+            trx->getValue(),
+            kDagBlockGasLimit,
+            trx->getData(),
+        },
+        proposal_period);
+    gas_estimation_time_us_ += std::chrono::duration_cast<std::chrono::microseconds>(
+                                   std::chrono::steady_clock::now() - start)
+                                   .count();
+
+    if (!result.code_err.empty() || !result.consensus_err.empty()) {
+      return 0;
+    }
+    return result.gas_used;
+  };
+  // State of the last block changes, so only estimations at specified period can be cached
+  if (!proposal_period) {
+    return *estimate();
+  }
+  return *gas_estimation_cache_.get(*proposal_period, trx->getHash(), estimate);
+}
+
+std::vector<uint64_t> TransactionManager::estimateTransactionsGas(const SharedTransactions &trxs,
+                                                                  std::optional<PbftPeriod> proposal_period) const {
+  std::vector<uint64_t> estimations(trxs.size());
+  runInChunks(gas_estimation_pool_.get(), kGasEstimationThreads, trxs.size(), kMinTrxsPerEstimationTask,
+              [&](size_t begin, size_t end) {
+                for (auto i = begin; i < end; ++i) {
+                  estimations[i] = estimateTransactionGas(trxs[i], proposal_period);
+                }
+              });
+  return estimations;
 }
 
 std::pair<bool, std::string> TransactionManager::verifyTransaction(const std::shared_ptr<Transaction> &trx) const {
@@ -76,6 +122,22 @@ std::pair<bool, std::string> TransactionManager::verifyTransaction(const std::sh
   return {true, ""};
 }
 
+void TransactionManager::recoverSenders(const SharedTransactions &trxs) const {
+  if (!sender_recovery_pool_) {
+    return;
+  }
+  runInChunks(sender_recovery_pool_.get(), kSenderRecoveryThreads, trxs.size(), kMinTrxsPerRecoveryTask,
+              [&trxs](size_t begin, size_t end) {
+                for (auto i = begin; i < end; ++i) {
+                  try {
+                    trxs[i]->getSender();
+                  } catch (...) {
+                    // Invalid signature is cached as well, errors are reported when transaction is verified
+                  }
+                }
+              });
+}
+
 bool TransactionManager::isTransactionKnown(const trx_hash_t &trx_hash) {
   return transactions_pool_.isTransactionKnown(trx_hash);
 }
@@ -110,8 +172,9 @@ TransactionStatus TransactionManager::insertValidatedTransaction(std::shared_ptr
 
   // This lock synchronizes inserting and removing transactions from transactions memory pool.
   // It is very important to lock transaction pool checking to be
-  // protected from new DAG block and Period data transactions insertions.
-  std::unique_lock transactions_lock(transactions_mutex_);
+  // protected from new DAG block and Period data transactions insertions. Transactions pool is thread safe itself, so
+  // inserts take shared lock and run in parallel, only moving transactions out of the pool takes unique lock.
+  std::shared_lock transactions_lock(transactions_mutex_);
 
   if (nonfinalized_transactions_in_dag_.contains(trx_hash)) {
     return TransactionStatus::Known;
@@ -150,7 +213,16 @@ TransactionStatus TransactionManager::insertValidatedTransaction(std::shared_ptr
 
   const auto last_block_number = final_chain_->lastBlockNumber();
   LOG(log_dg_) << "Transaction " << trx_hash << " inserted in trx pool";
-  return transactions_pool_.insert(std::move(tx), proposable, last_block_number);
+  if (!journal_worker_) {
+    return transactions_pool_.insert(std::move(tx), proposable, last_block_number);
+  }
+  auto journaled_tx = tx;
+  const auto status = transactions_pool_.insert(std::move(tx), proposable, last_block_number);
+  if (status == TransactionStatus::Inserted || status == TransactionStatus::InsertedNonProposable) {
+    std::unique_lock journal_lock(journal_mutex_);
+    journal_pending_.emplace_back(std::move(journaled_tx));
+  }
+  return status;
 }
 
 unsigned long TransactionManager::getTransactionCount() const {
@@ -195,11 +267,13 @@ void TransactionManager::saveTransactionsFromDagBlock(SharedTransactions const &
     // Unique lock here makes sure that transactions we are removing are not reinserted in transactions_pool_
     std::unique_lock transactions_lock(transactions_mutex_);
 
-    for (auto t : trxs) {
-      const auto tx_hash = t->getHash();
+    const auto trxs_finalized = db_->transactionsFinalized(trx_hashes);
+    for (size_t i = 0; i < trxs.size(); ++i) {
+      const auto &t = trxs[i];
+      const auto &tx_hash = trx_hashes[i];
 
       if (!recently_finalized_transactions_.contains(tx_hash) && !nonfinalized_transactions_in_dag_.contains(tx_hash) &&
-          !db_->transactionFinalized(tx_hash)) {
+          !trxs_finalized[i]) {
         db_->addTransactionToBatch(*t, write_batch);
         nonfinalized_transactions_in_dag_.emplace(tx_hash, t);
         if (transactions_pool_.erase(tx_hash)) {
@@ -244,6 +318,62 @@ void TransactionManager::recoverNonfinalizedTransactions() {
   db_->commitWriteBatch(write_batch);
 }
 
+void TransactionManager::restorePoolJournal() {
+  if (!journal_worker_) {
+    return;
+  }
+  auto trxs = db_->getPoolJournalTransactions();
+  if (trxs.empty()) {
+    return;
+  }
+  recoverSenders(trxs);
+
+  size_t restored = 0;
+  for (auto &trx : trxs) {
+    if (!verifyTransaction(trx).first) {
+      continue;
+    }
+    const auto status = insertValidatedTransaction(std::move(trx));
+    if (status == TransactionStatus::Inserted || status == TransactionStatus::InsertedNonProposable) {
+      restored++;
+    }
+  }
+  LOG(log_nf_) << "Restored " << restored << " of " << trxs.size() << " transactions from pool journal";
+
+  // Drop journaled transactions that were finalized or rejected while node was down
+  std::unique_lock journal_lock(journal_mutex_);
+  journal_flushes_ = kJournalCompactionFlushes - 1;
+}
+
+void TransactionManager::flushPoolJournal() {
+  SharedTransactions trxs;
+  bool compact = false;
+  {
+    std::unique_lock journal_lock(journal_mutex_);
+    trxs.swap(journal_pending_);
+    if (++journal_flushes_ >= kJournalCompactionFlushes) {
+      journal_flushes_ = 0;
+      compact = true;
+    }
+  }
+
+  auto write_batch = db_->createWriteBatch();
+  for (const auto &trx : trxs) {
+    db_->insert(write_batch, DbStorage::Columns::transactions_pool_journal, trx->getHash(), trx->rlp());
+  }
+  // Transactions are not removed from journal when they leave the pool, journal is compacted periodically instead
+  if (compact) {
+    auto it = db_->getColumnIterator(DbStorage::Columns::transactions_pool_journal);
+    for (it->SeekToFirst(); it->Valid(); it->Next()) {
+      const auto trx_hash = trx_hash_t(asBytes(it->key().ToString()));
+      if (!transactions_pool_.contains(trx_hash)) {
+        db_->remove(write_batch, DbStorage::Columns::transactions_pool_journal, trx_hash);
+      }
+    }
+  }
+  db_->commitWriteBatch(write_batch);
+}
+
 size_t TransactionManager::getTransactionPoolSize() const {
   std::shared_lock transactions_lock(transactions_mutex_);
   return transactions_pool_.size();
@@ -280,12 +410,17 @@ std::vector<std::shared_ptr<Transaction>> TransactionManager::getNonfinalizedTrx
 std::unordered_set<trx_hash_t> TransactionManager::excludeFinalizedTransactions(const std::vector<trx_hash_t> &hashes) {
   std::unordered_set<trx_hash_t> ret;
   ret.reserve(hashes.size());
+  std::vector<trx_hash_t> not_recently_finalized;
   std::shared_lock transactions_lock(transactions_mutex_);
   for (const auto &hash : hashes) {
     if (!recently_finalized_transactions_.contains(hash)) {
-      if (!db_->transactionFinalized(hash)) {
-        ret.insert(hash);
-      }
+      not_recently_finalized.push_back(hash);
+    }
+  }
+  const auto trxs_finalized = db_->transactionsFinalized(not_recently_finalized);
+  for (size_t i = 0; i < not_recently_finalized.size(); ++i) {
+    if (!trxs_finalized[i]) {
+      ret.insert(not_recently_finalized[i]);
     }
   }
   return ret;
@@ -304,15 +439,24 @@ std::pair<SharedTransactions, std::vector<uint64_t>> TransactionManager::packTrx
     std::shared_lock transactions_lock(transactions_mutex_);
     trxs = transactions_pool_.getOrderedTransactions(max_transactions_in_block);
   }
-  for (uint64_t i = 0; i < trxs.size(); i++) {
-    uint64_t weight;
-    weight = estimateTransactionGas(trxs[i], proposal_period);
-    total_weight += weight;
-    if (total_weight > weight_limit) {
-      trxs.resize(i);
-      break;
+  // Transactions are estimated in chunks, so no more than one chunk is dry run beyond the weight limit
+  for (size_t begin = 0; begin < trxs.size(); begin += kTrxsPerPackingChunk) {
+    const auto end = std::min(begin + kTrxsPerPackingChunk, trxs.size());
+    estimations.resize(end);
+    runInChunks(gas_estimation_pool_.get(), kGasEstimationThreads, end - begin, kMinTrxsPerEstimationTask,
+                [&](size_t chunk_begin, size_t chunk_end) {
+                  for (auto i = begin + chunk_begin; i < begin + chunk_end; ++i) {
+                    estimations[i] = estimateTransactionGas(trxs[i], proposal_period);
+                  }
+                });
+    for (auto i = begin; i < end; ++i) {
+      total_weight += estimations[i];
+      if (total_weight > weight_limit) {
+        trxs.resize(i);
+        estimations.resize(i);
+        return {trxs, estimations};
+      }
     }
-    estimations.push_back(weight);
   }
   return {trxs, estimations};
 }
@@ -431,7 +575,7 @@ SharedTransactions TransactionManager::getTransactions(const vec_trx_t &trxs_has
 }
 
 void TransactionManager::blockFinalized(EthBlockNumber block_number) {
-  std::unique_lock transactions_lock(transactions_mutex_);
+  std::shared_lock transactions_lock(transactions_mutex_);
   transactions_pool_.blockFinalized(block_number);
 }
 
@@ -1,5 +1,7 @@
 #include "transaction/transaction_queue.hpp"
 
+#include <queue>
+
 #include "transaction/transaction_manager.hpp"
 
 namespace taraxa {
@@ -10,22 +12,65 @@ TransactionQueue::TransactionQueue(std::shared_ptr<final_chain::FinalChain> fina
       kMaxSize(max_size),
       kMaxSingleAccountTransactionsSize(max_size * kSingleAccountTransactionsLimitPercentage / 100),
       final_chain_(final_chain) {
-  queue_transactions_.reserve(max_size);
+  for (auto &shard : hash_shards_) {
+    shard.queue_transactions.reserve(max_size / kShardsCount);
+  }
 }
 
-size_t TransactionQueue::size() const { return queue_transactions_.size(); }
+TransactionQueue::AccountsShard &TransactionQueue::accountsShard(const addr_t &sender) const {
+  return accounts_shards_[std::hash<addr_t>{}(sender) % kShardsCount];
+}
+
+TransactionQueue::HashShard &TransactionQueue::hashShard(const trx_hash_t &hash) const {
+  return hash_shards_[std::hash<trx_hash_t>{}(hash) % kShardsCount];
+}
+
+static std::shared_ptr<Transaction> headTransaction(const std::map<val_t, std::shared_ptr<Transaction>> &transactions) {
+  return transactions.empty() ? nullptr : transactions.begin()->second;
+}
+
+void TransactionQueue::AccountsShard::updateAccountIndex(const addr_t &sender,
+                                                         const std::shared_ptr<Transaction> &old_head,
+                                                         const NonceTransactions &transactions) {
+  const auto new_head = headTransaction(transactions);
+  if (old_head == new_head) {
+    return;
+  }
+  if (old_head) {
+    accounts_by_head_gas_price.erase({old_head->getGasPrice(), sender});
+  }
+  if (new_head) {
+    accounts_by_head_gas_price.emplace(new_head->getGasPrice(), sender);
+  }
+}
+
+std::vector<std::shared_lock<std::shared_mutex>> TransactionQueue::lockAccountsShards() const {
+  std::vector<std::shared_lock<std::shared_mutex>> locks;
+  locks.reserve(kShardsCount);
+  // Shards are always locked in the same order
+  for (auto &shard : accounts_shards_) {
+    locks.emplace_back(shard.mutex);
+  }
+  return locks;
+}
+
+size_t TransactionQueue::size() const { return queue_size_; }
 
 bool TransactionQueue::contains(const trx_hash_t &hash) const {
-  return queue_transactions_.contains(hash) || non_proposable_transactions_.contains(hash);
+  const auto &shard = hashShard(hash);
+  std::shared_lock lock(shard.mutex);
+  return shard.queue_transactions.contains(hash) || shard.non_proposable_transactions.contains(hash);
 }
 
 std::shared_ptr<Transaction> TransactionQueue::get(const trx_hash_t &hash) const {
-  if (const auto it = queue_transactions_.find(hash); it != queue_transactions_.end()) {
+  const auto &shard = hashShard(hash);
+  std::shared_lock lock(shard.mutex);
+  if (const auto it = shard.queue_transactions.find(hash); it != shard.queue_transactions.end()) {
     return it->second;
   }
 
-  if (const auto transaction = non_proposable_transactions_.find(hash);
-      transaction != non_proposable_transactions_.end()) {
+  if (const auto transaction = shard.non_proposable_transactions.find(hash);
+      transaction != shard.non_proposable_transactions.end()) {
     return transaction->second.second;
   }
 
@@ -34,37 +79,54 @@ std::shared_ptr<Transaction> TransactionQueue::get(const trx_hash_t &hash) const
 
 SharedTransactions TransactionQueue::getOrderedTransactions(uint64_t count) const {
   SharedTransactions ret;
-  ret.reserve(count);
-
-  std::multimap<val_t, std::shared_ptr<Transaction>, std::greater<val_t>> head_transactions;
-  std::unordered_map<addr_t, std::pair<std::map<val_t, std::shared_ptr<Transaction>>::const_iterator,
-                                       std::map<val_t, std::shared_ptr<Transaction>>::const_iterator>>
-      iterators;
-
-  iterators.reserve(account_nonce_transactions_.size());
-  // For accounts with multiple transactions we will iterate one level at a time
-  for (const auto &account : account_nonce_transactions_) {
-    iterators.insert({account.first, {account.second.begin(), account.second.end()}});
+  ret.reserve(std::min<uint64_t>(count, size()));
+  if (!count) {
+    return ret;
   }
 
-  for (auto it = iterators.begin(); it != iterators.end(); it++) {
-    head_transactions.insert({it->second.first->second->getGasPrice(), it->second.first->second});
-    // Increase iterator for an account
-    it->second.first++;
+  // Candidate is either head transaction of the next account in shard order or next nonce transaction of an account
+  // whose previous transaction was already taken
+  struct Candidate {
+    std::shared_ptr<Transaction> trx;
+    NonceTransactions::const_iterator next_nonce_it;
+    NonceTransactions::const_iterator account_end;
+    // Set only for account head candidates, next account of the shard becomes candidate once this one is taken
+    std::optional<std::pair<decltype(AccountsShard::accounts_by_head_gas_price)::const_iterator,
+                            const AccountsShard *>>
+        shard_cursor;
+  };
+  const auto lower_priority = [](const Candidate &a, const Candidate &b) {
+    return a.trx->getGasPrice() < b.trx->getGasPrice();
+  };
+  std::priority_queue<Candidate, std::vector<Candidate>, decltype(lower_priority)> candidates(lower_priority);
+  const auto push_account_head = [&candidates](const AccountsShard &shard, auto account_it) {
+    if (account_it == shard.accounts_by_head_gas_price.end()) {
+      return;
+    }
+    const auto &transactions = shard.account_nonce_transactions.at(account_it->second);
+    candidates.push({transactions.begin()->second, std::next(transactions.begin()), transactions.end(),
+                     std::make_pair(account_it, &shard)});
+  };
+
+  const auto locks = lockAccountsShards();
+  for (const auto &shard : accounts_shards_) {
+    push_account_head(shard, shard.accounts_by_head_gas_price.begin());
   }
-  while (!head_transactions.empty()) {
+  while (!candidates.empty()) {
     // Take transactions with highest gas and put it in ordered transactions
-    auto head_trx = head_transactions.begin();
-    ret.push_back(head_trx->second);
+    auto candidate = candidates.top();
+    candidates.pop();
+    ret.push_back(std::move(candidate.trx));
     if (ret.size() == count) {
       break;
     }
-    // If there is next nonce transaction of same account put it in head transactions
-    auto &it = iterators[head_trx->second->getSender()];
-    head_transactions.erase(head_trx);
-    if (it.first != it.second) {
-      head_transactions.insert({it.first->second->getGasPrice(), it.first->second});
-      it.first++;
+    if (candidate.shard_cursor) {
+      const auto &[account_it, shard] = *candidate.shard_cursor;
+      push_account_head(*shard, std::next(account_it));
+    }
+    // If there is next nonce transaction of same account it becomes candidate
+    if (candidate.next_nonce_it != candidate.account_end) {
+      candidates.push({candidate.next_nonce_it->second, std::next(candidate.next_nonce_it), candidate.account_end, {}});
     }
   }
 
@@ -73,40 +135,67 @@ SharedTransactions TransactionQueue::getOrderedTransactions(uint64_t count) cons
 
 std::vector<SharedTransactions> TransactionQueue::getAllTransactions() const {
   std::vector<SharedTransactions> ret;
-  ret.reserve(account_nonce_transactions_.size());
-  for (const auto &account_it : account_nonce_transactions_) {
-    SharedTransactions trxs_per_account;
-    trxs_per_account.reserve(account_it.second.size());
-    for (const auto &t : account_it.second) {
-      trxs_per_account.emplace_back(t.second);
+  const auto locks = lockAccountsShards();
+  for (const auto &shard : accounts_shards_) {
+    for (const auto &account_it : shard.account_nonce_transactions) {
+      SharedTransactions trxs_per_account;
+      trxs_per_account.reserve(account_it.second.size());
+      for (const auto &t : account_it.second) {
+        trxs_per_account.emplace_back(t.second);
+      }
+      ret.emplace_back(std::move(trxs_per_account));
     }
-    ret.emplace_back(std::move(trxs_per_account));
   }
   return ret;
 }
 
 bool TransactionQueue::erase(const trx_hash_t &hash) {
-  // Find the hash
-  const auto it = queue_transactions_.find(hash);
-  if (it == queue_transactions_.end()) {
-    return non_proposable_transactions_.erase(hash) > 0;
+  const auto transaction = get(hash);
+  if (!transaction) {
+    return false;
+  }
+
+  // Transaction is moved in or out of queue only under its sender account shard lock, so with both locks taken its
+  // state is consistent
+  auto &accounts_shard = accountsShard(transaction->getSender());
+  std::unique_lock accounts_lock(accounts_shard.mutex);
+  auto &hash_shard = hashShard(hash);
+  std::unique_lock hash_lock(hash_shard.mutex);
+
+  if (hash_shard.non_proposable_transactions.erase(hash)) {
+    non_proposable_size_--;
+    return true;
+  }
+  if (!hash_shard.queue_transactions.erase(hash)) {
+    return false;
   }
+  queue_size_--;
 
-  const auto &account_it = account_nonce_transactions_.find(it->second->getSender());
-  assert(account_it != account_nonce_transactions_.end());
-  const auto &nonce_it = account_it->second.find(it->second->getNonce());
+  const auto &account_it = accounts_shard.account_nonce_transactions.find(transaction->getSender());
+  assert(account_it != accounts_shard.account_nonce_transactions.end());
+  const auto &nonce_it = account_it->second.find(transaction->getNonce());
   assert(nonce_it != account_it->second.end());
   assert(hash == nonce_it->second->getHash());
 
+  const auto old_head = headTransaction(account_it->second);
   account_it->second.erase(nonce_it);
+  accounts_shard.updateAccountIndex(account_it->first, old_head, account_it->second);
   if (account_it->second.size() == 0) {
-    account_nonce_transactions_.erase(account_it);
+    accounts_shard.account_nonce_transactions.erase(account_it);
   }
-  queue_transactions_.erase(it);
 
   return true;
 }
 
+bool TransactionQueue::insertNonProposable(HashShard &shard, const std::shared_ptr<Transaction> &transaction,
+                                           uint64_t last_block_number) {
+  if (!shard.non_proposable_transactions.try_emplace(transaction->getHash(), last_block_number, transaction).second) {
+    return false;
+  }
+  non_proposable_size_++;
+  return true;
+}
+
 TransactionStatus TransactionQueue::insert(std::shared_ptr<Transaction> &&transaction, bool proposable,
                                            uint64_t last_block_number) {
   assert(transaction);
@@ -116,108 +205,166 @@ TransactionStatus TransactionQueue::insert(std::shared_ptr<Transaction> &&transa
     return TransactionStatus::Known;
   }
 
-  if (proposable) {
-    const auto &account_it = account_nonce_transactions_.find(transaction->getSender());
-    if (account_it == account_nonce_transactions_.end()) {
-      account_nonce_transactions_[transaction->getSender()][transaction->getNonce()] = transaction;
-      queue_transactions_[tx_hash] = transaction;
-    } else {
-      if (account_it->second.size() == kMaxSingleAccountTransactionsSize) {
-        transaction_overflow_time_ = std::chrono::system_clock::now();
-        return TransactionStatus::Overflow;
-      }
-      const auto &nonce_it = account_it->second.find(transaction->getNonce());
-      if (nonce_it == account_it->second.end()) {
-        account_nonce_transactions_[transaction->getSender()][transaction->getNonce()] = transaction;
-        queue_transactions_[tx_hash] = transaction;
-      } else {
-        // It should not be possible that transaction is already inside due to verification done before
-        assert(nonce_it->second->getHash() != tx_hash);
-        // Replace transaction if gas price higher
-        if (transaction->getGasPrice() > nonce_it->second->getGasPrice()) {
-          // Place same nonce transaction with lower gas price in non proposable transactions since it could be
-          // possible that some dag block might contain it
-          non_proposable_transactions_[nonce_it->second->getHash()] = {last_block_number, nonce_it->second};
-          queue_transactions_.erase(nonce_it->second->getHash());
-          account_nonce_transactions_[transaction->getSender()][transaction->getNonce()] = transaction;
-          queue_transactions_[tx_hash] = transaction;
-        } else {
-          non_proposable_transactions_[tx_hash] = {last_block_number, transaction};
-        }
+  auto &hash_shard = hashShard(tx_hash);
+  if (!proposable) {
+    if (non_proposable_size_ > kNonProposableTransactionsMaxSize) {
+      transaction_overflow_time_ = std::chrono::system_clock::now();
+      return TransactionStatus::Overflow;
+    }
+    {
+      std::unique_lock hash_lock(hash_shard.mutex);
+      // Same transaction could be inserted concurrently
+      if (hash_shard.queue_transactions.contains(tx_hash) ||
+          !insertNonProposable(hash_shard, transaction, last_block_number)) {
+        return TransactionStatus::Known;
       }
     }
+    known_txs_.insert(tx_hash);
+    return TransactionStatus::InsertedNonProposable;
+  }
 
-    const auto queue_size = size();
-    // This check if priority_queue_ is not bigger than max size if so we delete 1% of transactions
-    if (queue_size > kMaxSize) [[unlikely]] {
-      auto ordered_transactions = getOrderedTransactions(queue_size);
-      uint32_t counter = 0;
-      for (auto it = ordered_transactions.rbegin(); it != ordered_transactions.rend(); it++) {
-        transaction_overflow_time_ = std::chrono::system_clock::now();
-        erase((*it)->getHash());
-        known_txs_.erase((*it)->getHash());
-        counter++;
-        if (counter >= queue_size / 100) break;
+  {
+    const auto &sender = transaction->getSender();
+    auto &accounts_shard = accountsShard(sender);
+    std::unique_lock accounts_lock(accounts_shard.mutex);
+    auto &nonce_transactions = accounts_shard.account_nonce_transactions[sender];
+    if (!nonce_transactions.empty() && nonce_transactions.size() == kMaxSingleAccountTransactionsSize) {
+      transaction_overflow_time_ = std::chrono::system_clock::now();
+      return TransactionStatus::Overflow;
+    }
+
+    const auto old_head = headTransaction(nonce_transactions);
+    const auto [nonce_it, inserted] = nonce_transactions.try_emplace(transaction->getNonce(), transaction);
+    if (inserted) {
+      accounts_shard.updateAccountIndex(sender, old_head, nonce_transactions);
+      std::unique_lock hash_lock(hash_shard.mutex);
+      // Transaction inserted concurrently as non proposable becomes proposable
+      if (hash_shard.non_proposable_transactions.erase(tx_hash)) {
+        non_proposable_size_--;
       }
-      if (!queue_transactions_.contains(tx_hash)) {
-        return TransactionStatus::Overflow;
+      hash_shard.queue_transactions[tx_hash] = transaction;
+      queue_size_++;
+    } else if (nonce_it->second->getHash() == tx_hash) {
+      // Same transaction was inserted concurrently
+      return TransactionStatus::Known;
+    } else if (transaction->getGasPrice() > nonce_it->second->getGasPrice()) {
+      // Replace transaction if gas price higher. Place same nonce transaction with lower gas price in non proposable
+      // transactions since it could be possible that some dag block might contain it
+      auto replaced = std::move(nonce_it->second);
+      nonce_it->second = transaction;
+      accounts_shard.updateAccountIndex(sender, old_head, nonce_transactions);
+      {
+        auto &replaced_shard = hashShard(replaced->getHash());
+        std::unique_lock hash_lock(replaced_shard.mutex);
+        replaced_shard.queue_transactions.erase(replaced->getHash());
+        insertNonProposable(replaced_shard, replaced, last_block_number);
       }
-    }
-    known_txs_.insert(tx_hash);
-  } else {
-    if (non_proposable_transactions_.size() <= kNonProposableTransactionsMaxSize) {
-      non_proposable_transactions_[tx_hash] = {last_block_number, transaction};
-      known_txs_.insert(tx_hash);
-      return TransactionStatus::InsertedNonProposable;
+      std::unique_lock hash_lock(hash_shard.mutex);
+      if (hash_shard.non_proposable_transactions.erase(tx_hash)) {
+        non_proposable_size_--;
+      }
+      hash_shard.queue_transactions[tx_hash] = transaction;
     } else {
-      transaction_overflow_time_ = std::chrono::system_clock::now();
+      std::unique_lock hash_lock(hash_shard.mutex);
+      insertNonProposable(hash_shard, transaction, last_block_number);
+    }
+  }
+
+  // This check if queue is not bigger than max size if so we delete 1% of transactions
+  if (size() > kMaxSize) [[unlikely]] {
+    dropLowestPriorityTransactions();
+    std::shared_lock hash_lock(hash_shard.mutex);
+    if (!hash_shard.queue_transactions.contains(tx_hash)) {
       return TransactionStatus::Overflow;
     }
   }
+  known_txs_.insert(tx_hash);
   return TransactionStatus::Inserted;
 }
 
+void TransactionQueue::dropLowestPriorityTransactions() {
+  std::unique_lock lock(overflow_mutex_);
+  // Queue could be already reduced by concurrent insert
+  const auto queue_size = size();
+  if (queue_size <= kMaxSize) {
+    return;
+  }
+
+  auto ordered_transactions = getOrderedTransactions(queue_size);
+  uint32_t counter = 0;
+  for (auto it = ordered_transactions.rbegin(); it != ordered_transactions.rend(); it++) {
+    transaction_overflow_time_ = std::chrono::system_clock::now();
+    erase((*it)->getHash());
+    known_txs_.erase((*it)->getHash());
+    counter++;
+    if (counter >= queue_size / 100) break;
+  }
+}
+
 void TransactionQueue::blockFinalized(uint64_t block_number) {
-  for (auto it = non_proposable_transactions_.begin(); it != non_proposable_transactions_.end();) {
-    if (it->second.first + kNonProposableTransactionsPeriodExpiryLimit < block_number) {
-      known_txs_.erase(it->first);
-      it = non_proposable_transactions_.erase(it);
-    } else {
-      ++it;
+  for (auto &shard : hash_shards_) {
+    std::unique_lock lock(shard.mutex);
+    for (auto it = shard.non_proposable_transactions.begin(); it != shard.non_proposable_transactions.end();) {
+      if (it->second.first + kNonProposableTransactionsPeriodExpiryLimit < block_number) {
+        known_txs_.erase(it->first);
+        it = shard.non_proposable_transactions.erase(it);
+        non_proposable_size_--;
+      } else {
+        ++it;
+      }
     }
   }
 }
 
 void TransactionQueue::purge() {
-  for (auto account_it = account_nonce_transactions_.begin(); account_it != account_nonce_transactions_.end();) {
-    const auto account = final_chain_->getAccount(account_it->first);
-    if (account.has_value()) {
+  for (auto &shard : accounts_shards_) {
+    // Accounts are read with single batched call outside of the lock
+    std::vector<addr_t> senders;
+    {
+      std::shared_lock lock(shard.mutex);
+      senders.reserve(shard.account_nonce_transactions.size());
+      for (const auto &account_it : shard.account_nonce_transactions) {
+        senders.push_back(account_it.first);
+      }
+    }
+    if (senders.empty()) {
+      continue;
+    }
+    const auto accounts = final_chain_->getAccounts(senders);
+
+    std::unique_lock lock(shard.mutex);
+    for (size_t i = 0; i < senders.size(); ++i) {
+      const auto account_it = shard.account_nonce_transactions.find(senders[i]);
+      if (!accounts[i].has_value() || account_it == shard.account_nonce_transactions.end()) {
+        continue;
+      }
+      const auto old_head = headTransaction(account_it->second);
       for (auto nonce_it = account_it->second.begin(); nonce_it != account_it->second.end();) {
-        if (nonce_it->first < account->nonce) {
-          queue_transactions_.erase(nonce_it->second->getHash());
+        if (nonce_it->first < accounts[i]->nonce) {
+          auto &hash_shard = hashShard(nonce_it->second->getHash());
+          std::unique_lock hash_lock(hash_shard.mutex);
+          hash_shard.queue_transactions.erase(nonce_it->second->getHash());
+          queue_size_--;
           nonce_it = account_it->second.erase(nonce_it);
         } else {
           break;
         }
       }
 
+      shard.updateAccountIndex(senders[i], old_head, account_it->second);
       if (account_it->second.size() == 0) {
-        account_it = account_nonce_transactions_.erase(account_it);
-      } else {
-        account_it++;
+        shard.account_nonce_transactions.erase(account_it);
       }
-    } else {
-      account_it++;
     }
   }
 }
 
 bool TransactionQueue::nonProposableTransactionsOverTheLimit() const {
-  return non_proposable_transactions_.size() >= kNonProposableTransactionsMaxSize;
+  return non_proposable_size_ >= kNonProposableTransactionsMaxSize;
 }
 
 void TransactionQueue::markTransactionKnown(const trx_hash_t &trx_hash) { known_txs_.insert(trx_hash); }
 
 bool TransactionQueue::isTransactionKnown(const trx_hash_t &trx_hash) const { return known_txs_.contains(trx_hash); }
 
-}  // namespace taraxa
\ No newline at end of file
+}  // namespace taraxa
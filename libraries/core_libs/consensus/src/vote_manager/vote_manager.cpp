@@ -3,6 +3,7 @@
 #include <libdevcore/SHA3.h>
 #include <libdevcrypto/Common.h>
 
+#include <map>
 #include <optional>
 #include <shared_mutex>
 
@@ -926,6 +927,23 @@ std::pair<bool, std::string> VoteManager::validateVote(const std::shared_ptr<Pbf
   return {true, ""};
 }
 
+void VoteManager::prefetchVotersVoteCounts(const std::vector<std::shared_ptr<PbftVote>>& votes) const {
+  std::map<PbftPeriod, std::vector<addr_t>> voters_by_period;
+  for (const auto& vote : votes) {
+    if (vote->getPeriod() > 0) {
+      voters_by_period[vote->getPeriod()].push_back(vote->getVoterAddr());
+    }
+  }
+
+  for (const auto& [period, voters] : voters_by_period) {
+    try {
+      final_chain_->dposEligibleVoteCounts(period - 1, voters);
+    } catch (state_api::ErrFutureBlock&) {
+      // Such votes are reported by validateVote
+    }
+  }
+}
+
 std::optional<uint64_t> VoteManager::getPbftTwoTPlusOne(PbftPeriod pbft_period, PbftVoteTypes vote_type) const {
   // Check cache first
   {
@@ -4,6 +4,7 @@
 #include <libdevcore/CommonData.h>
 #include <libdevcore/CommonJS.h>
 
+#include <map>
 #include <stdexcept>
 
 #include "LogFilter.hpp"
@@ -313,6 +314,39 @@ class EthImpl : public Eth, EthParams {
 
   void note_pending_transaction(const h256& trx_hash) override { watches_.new_transactions_.process_update(trx_hash); }
 
+  void prefetch_batch(const Json::Value& requests) override {
+    std::map<EthBlockNumber, std::vector<Address>> accounts_by_block;
+    for (const auto& req : requests) {
+      // Invalid requests are skipped here and reported when handled
+      try {
+        if (!req.isObject() || !req["params"].isArray() || req["params"].size() != 2) {
+          continue;
+        }
+        const auto& params = req["params"];
+        const auto method = req["method"].asString();
+        if (method == "eth_getBalance" || method == "eth_getTransactionCount") {
+          accounts_by_block[get_block_number_from_json(params[1])].push_back(toAddress(params[0].asString()));
+        } else if (method == "eth_call" && params[0].isObject() && params[0]["nonce"].empty()) {
+          // Sender nonce is read by prepare_transaction_for_call
+          const auto from = params[0]["from"].empty() ? ZeroAddress : toAddress(params[0]["from"].asString());
+          accounts_by_block[get_block_number_from_json(params[1])].push_back(from);
+        }
+      } catch (...) {
+      }
+    }
+
+    for (const auto& [blk_n, addrs] : accounts_by_block) {
+      if (addrs.size() < 2) {
+        continue;
+      }
+      try {
+        final_chain->getAccounts(addrs, blk_n);
+      } catch (...) {
+        // Errors are reported by requests themselves
+      }
+    }
+  }
+
   Json::Value get_block_by_number(EthBlockNumber blk_n, bool include_transactions) {
     auto blk_header = final_chain->blockHeader(blk_n);
     if (!blk_header) {
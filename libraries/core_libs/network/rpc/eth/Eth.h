@@ -33,6 +33,11 @@ struct Eth : virtual ::taraxa::net::EthFace {
   virtual void note_block_executed(const final_chain::BlockHeader&, const SharedTransactions&,
                                    const final_chain::TransactionReceipts&) = 0;
   virtual void note_pending_transaction(const h256& trx_hash) = 0;
+  /**
+   * @brief Reads accounts of all balance, nonce and call requests of JSON-RPC batch at once, so handling of each
+   *        request gets them from final chain cache
+   */
+  virtual void prefetch_batch(const Json::Value& requests) = 0;
 };
 
 std::shared_ptr<Eth> NewEth(EthParams&&);
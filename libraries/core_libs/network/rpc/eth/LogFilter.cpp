@@ -123,11 +123,18 @@ std::vector<LocalisedLogEntry> LogFilter::match_all(const final_chain::FinalChai
   std::vector<LocalisedLogEntry> ret;
 
   auto action = [&, this](EthBlockNumber blk_n) {
-    ExtendedTransactionLocation trx_loc{{{blk_n}, *final_chain.blockHash(blk_n)}};
+    const auto blk_hash = final_chain.blockHash(blk_n);
+    // Block could be pruned
+    if (!blk_hash) {
+      return;
+    }
+    ExtendedTransactionLocation trx_loc{{{blk_n}, *blk_hash}};
     auto hashes = final_chain.transactionHashes(trx_loc.period);
-    for (const auto& hash : *hashes) {
-      trx_loc.trx_hash = hash;
-      match_one(trx_loc, *final_chain.transactionReceipt(hash), [&](const auto& lle) { ret.push_back(lle); });
+    // Block transactions receipts go first, system transactions receipts are not matched
+    const auto receipts = final_chain.blockReceipts(blk_n);
+    for (size_t i = 0; i < std::min(hashes->size(), receipts.size()); ++i) {
+      trx_loc.trx_hash = (*hashes)[i];
+      match_one(trx_loc, receipts[i], [&](const auto& lle) { ret.push_back(lle); });
       ++trx_loc.position;
     }
   };
@@ -144,13 +151,14 @@ std::vector<LocalisedLogEntry> LogFilter::match_all(const final_chain::FinalChai
     }
     return ret;
   }
-  std::set<EthBlockNumber> matchingBlocks;
-  for (const auto& bloom : bloomPossibilities()) {
-    for (auto blk_n : final_chain.withBlockBloom(bloom, from_block_, to_blk_n)) {
-      matchingBlocks.insert(blk_n);
+  // Log index gives exact candidate blocks, blooms are used when it is not available
+  if (const auto blocks = final_chain.withLogIndex(addresses_, topics_[0], from_block_, to_blk_n)) {
+    for (auto blk_n : *blocks) {
+      action(blk_n);
     }
+    return ret;
   }
-  for (auto blk_n : matchingBlocks) {
+  for (auto blk_n : final_chain.withBlockBloom(bloomPossibilities(), from_block_, to_blk_n)) {
     action(blk_n);
   }
   return ret;
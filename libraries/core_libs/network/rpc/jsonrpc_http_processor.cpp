@@ -16,6 +16,25 @@ HttpProcessor::Response JsonRpcHttpProcessor::process(const Request &request) {
     assert(handler);
     response.set("Content-Type", "application/json");
     response.result(boost::beast::http::status::ok);
+    // Request is parsed at most once, malformed request is parsed to null value and its error is reported by handler
+    std::optional<Json::Value> req_json;
+    const auto parsed_request = [&]() -> const Json::Value & {
+      if (!req_json) {
+        try {
+          req_json = util::parse_json(request.body());
+        } catch (const std::exception &) {
+          req_json.emplace();
+        }
+      }
+      return *req_json;
+    };
+    if (batch_prefetcher_ && request.body().starts_with('[') && parsed_request().isArray()) {
+      // Prefetch is only an optimization, requests are handled even if it fails
+      try {
+        batch_prefetcher_(parsed_request());
+      } catch (const std::exception &) {
+      }
+    }
     try {
       handler->HandleRequest(request.body(), response.body());
     } catch (std::exception const &e) {
@@ -26,10 +45,10 @@ HttpProcessor::Response JsonRpcHttpProcessor::process(const Request &request) {
       auto const &err_msg = err->message.str();
       Json::Value res_json(Json::objectValue);
       res_json["jsonrpc"] = "2.0";
-      auto req_json = util::parse_json(request.body());
-      if (req_json.isObject() && req_json.isMember("id") &&  // this conditional was taken from jsonrpccpp sources
-          (req_json["id"].isNull() || req_json["id"].isIntegral() || req_json["id"].isString())) {
-        res_json["id"] = req_json["id"];
+      const auto &req = parsed_request();
+      if (req.isObject() && req.isMember("id") &&  // this conditional was taken from jsonrpccpp sources
+          (req["id"].isNull() || req["id"].isIntegral() || req["id"].isString())) {
+        res_json["id"] = req["id"];
       } else {
         res_json["id"] = Json::nullValue;
       }
@@ -20,6 +20,16 @@ class JsonRpcHttpProcessor final : public HttpProcessor, public jsonrpc::Abstrac
 
   bool StartListening() override { return true; }
   bool StopListening() override { return true; }
+
+  /**
+   * @brief Sets function called with batch requests before they are handled, so it could read their data at once
+   */
+  void setBatchPrefetcher(std::function<void(const Json::Value&)> prefetcher) {
+    batch_prefetcher_ = std::move(prefetcher);
+  }
+
+ private:
+  std::function<void(const Json::Value&)> batch_prefetcher_;
 };
 
 }  // namespace taraxa::net
\ No newline at end of file
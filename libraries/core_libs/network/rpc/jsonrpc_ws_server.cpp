@@ -30,6 +30,9 @@ std::string JsonRpcWsSession::processRequest(const std::string_view &request) {
     if (const auto method = json.get("method", ""); method == "eth_subscribe") {
       return handleSubscription(json);
     }
+  } else if (auto ws_server = std::static_pointer_cast<JsonRpcWsServer>(ws_server_.lock())) {
+    // Sessions of this type are created only by JsonRpcWsServer
+    ws_server->prefetchBatch(json);
   }
 
   return handleRequest(json);
@@ -18,6 +18,21 @@ class JsonRpcWsServer final : public WsServer {
  public:
   using WsServer::WsServer;
   std::shared_ptr<WsSession> createSession(tcp::socket&& socket) override;
+
+  /**
+   * @brief Sets function called with batch requests before they are handled, so it could read their data at once
+   */
+  void setBatchPrefetcher(std::function<void(const Json::Value&)> prefetcher) {
+    batch_prefetcher_ = std::move(prefetcher);
+  }
+  void prefetchBatch(const Json::Value& requests) const {
+    if (batch_prefetcher_) {
+      batch_prefetcher_(requests);
+    }
+  }
+
+ private:
+  std::function<void(const Json::Value&)> batch_prefetcher_;
 };
 
 }  // namespace taraxa::net
\ No newline at end of file
@@ -45,6 +45,7 @@ void DagSyncPacketHandler::process(DagSyncPacket&& packet, const std::shared_ptr
   std::unordered_map<trx_hash_t, std::shared_ptr<Transaction>> transactions_map;
   transactions_to_log.reserve(packet.transactions.size());
   transactions_map.reserve(packet.transactions.size());
+  SharedTransactions unseen_transactions;
   for (auto& trx : packet.transactions) {
     const auto tx_hash = trx->getHash();
     peer->markTransactionAsKnown(tx_hash);
@@ -54,16 +55,22 @@ void DagSyncPacketHandler::process(DagSyncPacket&& packet, const std::shared_ptr
     if (trx_mgr_->isTransactionKnown(tx_hash)) {
       continue;
     }
+    unseen_transactions.push_back(trx);
+  }
 
+  // Senders of the whole packet are recovered in parallel before transactions are verified one by one
+  trx_mgr_->recoverSenders(unseen_transactions);
+  for (const auto& trx : unseen_transactions) {
     auto [verified, reason] = trx_mgr_->verifyTransaction(trx);
     if (!verified) {
       std::ostringstream err_msg;
-      err_msg << "DagBlock transaction " << tx_hash << " validation failed: " << reason;
+      err_msg << "DagBlock transaction " << trx->getHash() << " validation failed: " << reason;
       throw MaliciousPeerException(err_msg.str());
     }
   }
 
   std::vector<blk_hash_t> dag_blocks_to_log;
+  std::vector<std::shared_ptr<DagBlock>> unknown_dag_blocks;
   dag_blocks_to_log.reserve(packet.dag_blocks.size());
   for (auto& block : packet.dag_blocks) {
     dag_blocks_to_log.push_back(block->getHash());
@@ -73,8 +80,18 @@ void DagSyncPacketHandler::process(DagSyncPacket&& packet, const std::shared_ptr
       LOG(log_tr_) << "Received known DagBlock " << block->getHash() << "from: " << peer->getId();
       continue;
     }
+    unknown_dag_blocks.push_back(block);
+  }
 
-    auto verified = dag_mgr_->verifyBlock(block, transactions_map);
+  // Blocks are verified in parallel and then added to the DAG in the received order
+  auto verified_blocks = dag_mgr_->verifyBlocks(unknown_dag_blocks, transactions_map);
+  for (size_t i = 0; i < unknown_dag_blocks.size(); ++i) {
+    const auto& block = unknown_dag_blocks[i];
+    auto& verified = verified_blocks[i];
+    if (verified.first == DagManager::VerifyBlockReturnType::MissingTip) {
+      // Tips could be blocks of this packet that were not in the DAG yet when blocks were verified in parallel
+      verified = dag_mgr_->verifyBlock(block, transactions_map);
+    }
     if (verified.first != DagManager::VerifyBlockReturnType::Verified) {
       std::ostringstream err_msg;
       err_msg << "DagBlock " << block->getHash() << " failed verification with error code "
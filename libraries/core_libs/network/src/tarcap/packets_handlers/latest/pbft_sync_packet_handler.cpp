@@ -132,6 +132,7 @@ void PbftSyncPacketHandler::process(PbftSyncPacket &&packet, const std::shared_p
     // This is special case when queue is empty and we can not say for sure that all votes that are part of this block
     // have been verified before
     if (pbft_mgr_->periodDataQueueEmpty()) {
+      vote_mgr_->prefetchVotersVoteCounts(packet.period_data.previous_block_cert_votes);
       for (const auto &v : packet.period_data.previous_block_cert_votes) {
         if (auto vote_is_valid = vote_mgr_->validateVote(v); vote_is_valid.first == false) {
           LOG(log_er_) << "Invalid reward votes in block " << packet.period_data.pbft_blk->getBlockHash()
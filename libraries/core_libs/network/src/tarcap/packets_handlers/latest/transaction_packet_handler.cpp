@@ -32,7 +32,8 @@ inline void TransactionPacketHandler::process(TransactionPacket &&packet, const
     peer->markTransactionAsKnown(extra_tx_hash);
   }
 
-  size_t unseen_txs_count = 0;
+  SharedTransactions unseen_txs;
+  unseen_txs.reserve(packet.transactions.size());
   for (auto &transaction : packet.transactions) {
     const auto tx_hash = transaction->getHash();
     peer->markTransactionAsKnown(tx_hash);
@@ -41,9 +42,14 @@ inline void TransactionPacketHandler::process(TransactionPacket &&packet, const
     if (trx_mgr_->isTransactionKnown(tx_hash)) {
       continue;
     }
+    unseen_txs.push_back(std::move(transaction));
+  }
 
-    unseen_txs_count++;
+  // Senders of the whole packet are recovered in parallel before transactions are verified one by one
+  trx_mgr_->recoverSenders(unseen_txs);
 
+  for (auto &transaction : unseen_txs) {
+    const auto tx_hash = transaction->getHash();
     const auto [verified, reason] = trx_mgr_->verifyTransaction(transaction);
     if (!verified) {
       std::ostringstream err_msg;
@@ -69,7 +75,7 @@ inline void TransactionPacketHandler::process(TransactionPacket &&packet, const
   if (!packet.transactions.empty()) {
     LOG(log_tr_) << "Received TransactionPacket with " << packet.transactions.size() << " transactions";
     LOG(log_dg_) << "Received TransactionPacket with " << packet.transactions.size()
-                 << " unseen transactions:" << unseen_txs_count << " from: " << peer->getId().abridged();
+                 << " unseen transactions:" << unseen_txs.size() << " from: " << peer->getId().abridged();
   }
 }
 
@@ -14,6 +14,8 @@
 #include "graphql/http_processor.hpp"
 #include "graphql/ws_server.hpp"
 #include "key_manager/key_manager.hpp"
+#include "metrics/db_metrics.hpp"
+#include "metrics/final_chain_metrics.hpp"
 #include "metrics/metrics_service.hpp"
 #include "metrics/network_metrics.hpp"
 #include "metrics/pbft_metrics.hpp"
@@ -62,16 +64,20 @@ void FullNode::init() {
     assert(false);
   }
   {
+    // Db statistics are only consumed by metrics
+    conf_.db_config.rocksdb.statistics = conf_.network.prometheus.has_value();
     if (conf_.db_config.rebuild_db) {
       old_db_ = std::make_shared<DbStorage>(conf_.db_path, conf_.db_config.db_snapshot_each_n_pbft_block,
                                             conf_.db_config.db_max_open_files, conf_.db_config.db_max_snapshots,
-                                            conf_.db_config.db_revert_to_period, node_addr, true);
+                                            conf_.db_config.db_revert_to_period, node_addr, true,
+                                            conf_.db_config.rocksdb);
     }
     db_ = std::make_shared<DbStorage>(conf_.db_path,
                                       // Snapshots should be disabled while rebuilding
                                       conf_.db_config.rebuild_db ? 0 : conf_.db_config.db_snapshot_each_n_pbft_block,
                                       conf_.db_config.db_max_open_files, conf_.db_config.db_max_snapshots,
-                                      conf_.db_config.db_revert_to_period, node_addr, false);
+                                      conf_.db_config.db_revert_to_period, node_addr, false,
+                                      conf_.db_config.rocksdb);
 
     if (db_->hasMajorVersionChanged()) {
       LOG(log_si_) << "Major DB version has changed. Rebuilding Db";
@@ -79,14 +85,21 @@ void FullNode::init() {
       db_ = nullptr;
       old_db_ = std::make_shared<DbStorage>(conf_.db_path, conf_.db_config.db_snapshot_each_n_pbft_block,
                                             conf_.db_config.db_max_open_files, conf_.db_config.db_max_snapshots,
-                                            conf_.db_config.db_revert_to_period, node_addr, true);
+                                            conf_.db_config.db_revert_to_period, node_addr, true,
+                                            conf_.db_config.rocksdb);
       db_ = std::make_shared<DbStorage>(conf_.db_path,
                                         0,  // Snapshots should be disabled while rebuilding
                                         conf_.db_config.db_max_open_files, conf_.db_config.db_max_snapshots,
-                                        conf_.db_config.db_revert_to_period, node_addr);
+                                        conf_.db_config.db_revert_to_period, node_addr, false,
+                                        conf_.db_config.rocksdb);
     }
 
     db_->updateDbVersions();
+    if (!conf_.db_config.db_snapshots_backup_path.empty()) {
+      db_->enableSnapshotsBackup(conf_.db_config.db_snapshots_backup_path,
+                                 conf_.db_config.db_snapshots_backup_rate_limit_mb);
+    }
+    db_->setPruningRateLimit(conf_.db_config.db_prune_rate_limit_mb);
 
     auto migration_manager = storage::migration::Manager(db_);
     migration_manager.applyAll();
@@ -152,6 +165,13 @@ void FullNode::setupMetricsUpdaters() {
       [trx_mgr = trx_mgr_]() { return trx_mgr->getTransactionPoolSize(); });
   transaction_queue_metrics->setGasPriceUpdater(
       [gas_pricer = gas_pricer_]() { return gas_pricer->bid().convert_to<double>(); });
+  transaction_queue_metrics->setGasEstimationStatsUpdater(
+      [transaction_queue_metrics = transaction_queue_metrics.get(), trx_mgr = trx_mgr_]() {
+        const auto stats = trx_mgr->gasEstimationCacheStats();
+        transaction_queue_metrics->setGasEstimationCacheHits(stats.hits);
+        transaction_queue_metrics->setGasEstimationCacheMisses(stats.misses);
+        transaction_queue_metrics->setGasEstimationTime(trx_mgr->gasEstimationTimeUs());
+      });
 
   auto pbft_metrics = metrics_->getMetrics<metrics::PbftMetrics>();
   pbft_metrics->setPeriodUpdater([pbft_mgr = pbft_mgr_]() { return pbft_mgr->getPbftPeriod(); });
@@ -164,6 +184,47 @@ void FullNode::setupMetricsUpdaters() {
     pbft_metrics->setBlockTransactionsCount(res->trxs.size());
     pbft_metrics->setBlockTimestamp(res->final_chain_blk->timestamp);
   });
+
+  auto db_metrics = metrics_->getMetrics<metrics::DbMetrics>();
+  db_metrics->setStatsUpdater([db_metrics = db_metrics.get(), db = db_]() {
+    for (const auto &stats : db->getColumnsStats()) {
+      db_metrics->setColumnBloomBitsPerKey(stats.column, stats.bloom_bits_per_key);
+      db_metrics->setColumnBlockSize(stats.column, stats.block_size);
+      db_metrics->setColumnBlockCacheCapacity(stats.column, stats.block_cache_capacity);
+      db_metrics->setColumnBlockCacheUsage(stats.column, stats.block_cache_usage);
+      db_metrics->setColumnBlockCacheHit(stats.column, stats.block_cache_hit);
+      db_metrics->setColumnBlockCacheMiss(stats.column, stats.block_cache_miss);
+      db_metrics->setColumnEstimateNumKeys(stats.column, stats.estimate_num_keys);
+      db_metrics->setColumnLiveSstFilesSize(stats.column, stats.live_sst_files_size);
+    }
+
+    const auto cache_stats = db->getCacheStats();
+    db_metrics->setBlockCacheCapacity(cache_stats.block_cache_capacity);
+    db_metrics->setBlockCacheUsage(cache_stats.block_cache_usage);
+    db_metrics->setBlockCachePinnedUsage(cache_stats.block_cache_pinned_usage);
+    db_metrics->setBlockCacheHit(cache_stats.block_cache_hit);
+    db_metrics->setBlockCacheMiss(cache_stats.block_cache_miss);
+    db_metrics->setRowCacheCapacity(cache_stats.row_cache_capacity);
+    db_metrics->setRowCacheUsage(cache_stats.row_cache_usage);
+    db_metrics->setRowCacheHit(cache_stats.row_cache_hit);
+    db_metrics->setRowCacheMiss(cache_stats.row_cache_miss);
+    const auto pruning_stats = db->getPruningStats();
+    db_metrics->setPruningPeriodCursor(pruning_stats.period_cursor);
+    db_metrics->setPruningPeriodTarget(pruning_stats.period_target);
+    db_metrics->setPruningDagLevelCursor(pruning_stats.dag_level_cursor);
+    db_metrics->setPruningDagLevelTarget(pruning_stats.dag_level_target);
+    db_metrics->setPruningRemovedKeys(pruning_stats.removed_keys);
+  });
+
+  auto final_chain_metrics = metrics_->getMetrics<metrics::FinalChainMetrics>();
+  final_chain_metrics->setCachesStatsUpdater(
+      [final_chain_metrics = final_chain_metrics.get(), final_chain = final_chain_]() {
+        for (const auto &[cache, stats] : final_chain->cachesStats()) {
+          final_chain_metrics->setCacheHits(cache, stats.hits);
+          final_chain_metrics->setCacheMisses(cache, stats.misses);
+          final_chain_metrics->setCacheEvictions(cache, stats.evictions);
+        }
+      });
 }
 
 void FullNode::start() {
@@ -228,13 +289,18 @@ void FullNode::start() {
       jsonrpc_http_ = std::make_shared<net::HttpServer>(
           rpc_thread_pool_, boost::asio::ip::tcp::endpoint{conf_.network.rpc->address, *conf_.network.rpc->http_port},
           getAddress(), json_rpc_processor, conf_.network.rpc->max_pending_tasks);
+      json_rpc_processor->setBatchPrefetcher(
+          [eth_json_rpc](const Json::Value &requests) { eth_json_rpc->prefetch_batch(requests); });
       jsonrpc_api_->addConnector(json_rpc_processor);
       jsonrpc_http_->start();
     }
     if (conf_.network.rpc->ws_port) {
-      jsonrpc_ws_ = std::make_shared<net::JsonRpcWsServer>(
+      auto jsonrpc_ws = std::make_shared<net::JsonRpcWsServer>(
           rpc_thread_pool_, boost::asio::ip::tcp::endpoint{conf_.network.rpc->address, *conf_.network.rpc->ws_port},
           getAddress(), conf_.network.rpc->max_pending_tasks);
+      jsonrpc_ws->setBatchPrefetcher(
+          [eth_json_rpc](const Json::Value &requests) { eth_json_rpc->prefetch_batch(requests); });
+      jsonrpc_ws_ = std::move(jsonrpc_ws);
       jsonrpc_api_->addConnector(jsonrpc_ws_);
       jsonrpc_ws_->run();
     }
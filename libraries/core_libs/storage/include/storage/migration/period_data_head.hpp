@@ -0,0 +1,14 @@
+#pragma once
+#include "storage/migration/migration_base.hpp"
+
+namespace taraxa::storage::migration {
+class PeriodDataHead : public migration::Base {
+ public:
+  PeriodDataHead(std::shared_ptr<DbStorage> db);
+  std::string id() override;
+  uint32_t dbVersion() override;
+
+ protected:
+  void migrate(logger::Logger& log) override;
+};
+}  // namespace taraxa::storage::migration
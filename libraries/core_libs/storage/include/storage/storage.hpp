@@ -1,15 +1,19 @@
 #pragma once
 
+#include <rocksdb/cache.h>
 #include <rocksdb/db.h>
 #include <rocksdb/options.h>
 #include <rocksdb/slice.h>
 #include <rocksdb/write_batch.h>
 
+#include <condition_variable>
 #include <filesystem>
 #include <functional>
 #include <regex>
 
+#include "common/thread_pool.hpp"
 #include "common/types.hpp"
+#include "config/config.hpp"
 #include "dag/dag_block.hpp"
 #include "logger/logger.hpp"
 #include "pbft/pbft_block.hpp"
@@ -40,7 +44,10 @@ enum StatusDbField : uint8_t {
   DagBlkCount,
   DagEdgeCount,
   DbMajorVersion,
-  DbMinorVersion
+  DbMinorVersion,
+  // Cursors of history pruning, everything below them is already pruned
+  PrunedPeriod,
+  PrunedDagLevel
 };
 
 enum class PbftMgrField : uint8_t { Round = 0, Step };
@@ -52,7 +59,7 @@ enum PbftMgrStatus : uint8_t {
   NextVotedNullBlockHash,
 };
 
-enum class DBMetaKeys { LAST_NUMBER = 1 };
+enum class DBMetaKeys { LAST_NUMBER = 1, LOG_INDEX_FROM };
 
 class DbException : public std::exception {
  public:
@@ -145,13 +152,91 @@ class DbStorage : public std::enable_shared_from_this<DbStorage> {
     COLUMN(system_transaction);
     // system transactions hashes by period
     COLUMN(period_system_transactions);
+    // Period data with dag blocks and transactions left out, same item positions as in period_data. Pbft block and
+    // votes are stored twice, the copy here costs a few KB per period and spares decoding whole period data, which is
+    // dominated by dag blocks and transactions, when only the block or votes are read
+    COLUMN_W_COMP(period_data_head, getIntComparator<PbftPeriod>());
+    // Optional log index, log address/first topic + block number -> empty, filled only when log index is enabled
+    COLUMN(final_chain_log_index);
+    // Optional receipts of block stored as single blob, block number -> receipts blob
+    COLUMN_W_COMP(final_chain_receipts_by_block, getIntComparator<uint64_t>());
+    // Optional journal of transactions pool, trx hash -> transaction, filled only when pool journal is enabled
+    COLUMN(transactions_pool_journal);
 
 #undef COLUMN
 #undef COLUMN_W_COMP
   };
 
+  /**
+   * @brief Column holding RLP encoded values of type T
+   */
+  template <typename T>
+  struct TypedColumn {
+    Column const& column;
+  };
+
+  class TypedColumns {
+   public:
+    static inline const TypedColumn<PeriodData> period_data{Columns::period_data};
+    static inline const TypedColumn<DagBlock> dag_blocks{Columns::dag_blocks};
+    static inline const TypedColumn<Transaction> transactions{Columns::transactions};
+    static inline const TypedColumn<PbftBlock> proposed_pbft_blocks{Columns::proposed_pbft_blocks};
+    static inline const TypedColumn<PbftVote> latest_round_own_votes{Columns::latest_round_own_votes};
+    static inline const TypedColumn<PbftVote> extra_reward_votes{Columns::extra_reward_votes};
+  };
+
+  /**
+   * @brief Value pinned in rocksdb memtable or block cache. RLP is decoded directly from the pinned buffer instead of
+   * copying the value into std::string and dev::bytes first
+   */
+  class PinnedValue {
+   public:
+    bool empty() const { return value_.empty(); }
+    dev::bytesConstRef ref() const { return asBytesRef(value_); }
+    dev::RLP rlp() const { return dev::RLP(ref()); }
+    dev::bytes toBytes() const { return ref().toBytes(); }
+
+   private:
+    rocksdb::PinnableSlice value_;
+    friend class DbStorage;
+  };
+
   auto handle(Column const& col) const { return handles_[col.ordinal_]; }
 
+  struct ColumnStats {
+    std::string column;
+    std::string profile;
+    uint32_t bloom_bits_per_key = 0;
+    uint64_t block_size = 0;
+    uint64_t block_cache_capacity = 0;
+    uint64_t block_cache_usage = 0;
+    // Block cache hits/misses of point lookups done by DbStorage for this column, collected only with statistics
+    uint64_t block_cache_hit = 0;
+    uint64_t block_cache_miss = 0;
+    uint64_t estimate_num_keys = 0;
+    uint64_t live_sst_files_size = 0;
+  };
+
+  struct CacheStats {
+    uint64_t block_cache_capacity = 0;
+    uint64_t block_cache_usage = 0;
+    uint64_t block_cache_pinned_usage = 0;
+    uint64_t block_cache_hit = 0;
+    uint64_t block_cache_miss = 0;
+    uint64_t row_cache_capacity = 0;
+    uint64_t row_cache_usage = 0;
+    uint64_t row_cache_hit = 0;
+    uint64_t row_cache_miss = 0;
+  };
+
+  struct PruningStats {
+    PbftPeriod period_cursor = 0;
+    PbftPeriod period_target = 0;
+    uint64_t dag_level_cursor = 0;
+    uint64_t dag_level_target = 0;
+    uint64_t removed_keys = 0;
+  };
+
  private:
   fs::path path_;
   fs::path db_path_;
@@ -160,7 +245,15 @@ class DbStorage : public std::enable_shared_from_this<DbStorage> {
   const std::string kStateDbDir = "state_db";
   std::unique_ptr<rocksdb::DB> db_;
   std::vector<rocksdb::ColumnFamilyHandle*> handles_;
+  struct ColumnCacheCounters {
+    std::atomic<uint64_t> hit = 0;
+    std::atomic<uint64_t> miss = 0;
+  };
+  // Indexed by column ordinal
+  mutable std::vector<ColumnCacheCounters> columns_cache_counters_;
   rocksdb::ReadOptions read_options_;
+  // Used for MultiGet, allows reads of different sst files to be issued in parallel
+  rocksdb::ReadOptions multi_get_read_options_;
   rocksdb::WriteOptions write_options_;
   std::mutex dag_blocks_mutex_;
   std::atomic<uint64_t> dag_blocks_count_;
@@ -170,6 +263,64 @@ class DbStorage : public std::enable_shared_from_this<DbStorage> {
   const uint32_t kDbSnapshotsMaxCount = 0;
   std::set<PbftPeriod> snapshots_;
 
+  const RocksDbConfig kRocksDbConfig;
+  // Column family options indexed by column ordinal, built from configured column profiles
+  std::vector<rocksdb::ColumnFamilyOptions> columns_options_;
+  // Block cache of each profile that has block_cache_mb configured
+  std::unordered_map<std::string, std::shared_ptr<rocksdb::Cache>> profiles_block_caches_;
+  // Block cache shared by all columns that do not have own profile cache
+  std::shared_ptr<rocksdb::Cache> shared_block_cache_;
+  std::shared_ptr<rocksdb::Cache> row_cache_;
+  // Null if statistics are disabled, column cache counters are not collected either then
+  std::shared_ptr<rocksdb::Statistics> statistics_;
+
+  // Runs the read and adds block cache hits/misses it caused to the column counters
+  void countColumnCacheAccess(Column const& column, const std::function<void()>& read) const;
+
+  fs::path snapshots_backup_path_;
+  std::unique_ptr<rocksdb::RateLimiter> snapshots_backup_rate_limiter_;
+  std::function<void(PbftPeriod, const fs::path&)> snapshot_backup_hook_;
+  // Snapshots backup and removal of old snapshots run on this worker, out of the pbft finalization path
+  util::ThreadPool snapshots_worker_{1};
+  // Backup hook runs on own worker, so e.g. slow upload doesn't delay next backups and removal of old snapshots
+  util::ThreadPool snapshot_backup_hook_worker_{1};
+
+  void backupSnapshot(PbftPeriod period);
+  Json::Value backupSnapshotDir(const fs::path& snapshot_path, const fs::path& shared_path,
+                                const fs::path& backup_path);
+  void copyFileRateLimited(const fs::path& from, const fs::path& to);
+  static std::string sstFileId(const fs::path& path);
+
+  struct PruningTarget {
+    PbftPeriod period = 0;
+    uint64_t dag_level = 0;
+    bool operator==(const PruningTarget&) const = default;
+  };
+  // Number of periods/dag levels deleted in single write batch
+  static constexpr uint64_t kPruningChunkSize = 1000;
+  // Failed pruning is retried with delay doubled after each failure
+  static constexpr std::chrono::seconds kPruningRetryDelay{1};
+  static constexpr std::chrono::seconds kMaxPruningRetryDelay{60};
+  mutable std::mutex pruning_mutex_;
+  // Wakes up pruning waiting for retry when storage is destroyed
+  std::condition_variable pruning_cv_;
+  // Protected by pruning_mutex_
+  PruningTarget pruning_target_;
+  PruningTarget pruning_done_target_;
+  bool pruning_scheduled_ = false;
+  std::atomic<PbftPeriod> pruning_period_cursor_ = 0;
+  std::atomic<uint64_t> pruning_dag_level_cursor_ = 0;
+  std::atomic<uint64_t> pruning_removed_keys_ = 0;
+  std::atomic<bool> pruning_stopped_ = false;
+  std::unique_ptr<rocksdb::RateLimiter> pruning_rate_limiter_;
+  // History pruning runs on this worker so it does not block node startup
+  util::ThreadPool pruning_worker_{1};
+
+  void pruneHistory();
+  void prunePeriodData(PbftPeriod end_period);
+  void pruneDagLevels(uint64_t dag_level_to_keep);
+  void commitPruningBatch(Batch& write_batch);
+
   uint32_t kMajorVersion_;
   bool major_version_changed_ = false;
   bool minor_version_changed_ = false;
@@ -179,7 +330,7 @@ class DbStorage : public std::enable_shared_from_this<DbStorage> {
  public:
   explicit DbStorage(fs::path const& base_path, uint32_t db_snapshot_each_n_pbft_block = 0, uint32_t max_open_files = 0,
                      uint32_t db_max_snapshots = 0, PbftPeriod db_revert_to_period = 0, addr_t node_addr = addr_t(),
-                     bool rebuild = false);
+                     bool rebuild = false, const RocksDbConfig& rocksdb_config = {});
   ~DbStorage();
 
   DbStorage(const DbStorage&) = delete;
@@ -195,8 +346,31 @@ class DbStorage : public std::enable_shared_from_this<DbStorage> {
   void commitWriteBatch(Batch& write_batch) { commitWriteBatch(write_batch, write_options_); }
 
   void rebuildColumns(const rocksdb::Options& options);
+  void initColumnsOptions();
+  rocksdb::ColumnFamilyOptions getColumnOptions(const std::string& column_name) const;
+  std::vector<ColumnStats> getColumnsStats() const;
+  CacheStats getCacheStats() const;
+  bool isSnapshotPeriod(PbftPeriod period) const;
   bool createSnapshot(PbftPeriod period);
   void deleteSnapshot(PbftPeriod period);
+  /**
+   * @brief Enables incremental backup of snapshots. SST files shared by consecutive snapshots are stored in backup
+   * only once, each snapshot gets a manifest listing files it consists of
+   *
+   * @param backup_path
+   * @param rate_limit_mb IO rate limit of copying files to backup in MB/s, 0 means unlimited
+   */
+  void enableSnapshotsBackup(const fs::path& backup_path, uint32_t rate_limit_mb);
+  using SnapshotBackupHook = std::function<void(PbftPeriod, const fs::path&)>;
+  /**
+   * @brief Sets hook called with snapshot period and manifest path once snapshot checkpoint is backed up, e.g. to upload
+   * backup to a remote storage. Hook is called on own worker, not on snapshots worker
+   */
+  void setSnapshotBackupHook(SnapshotBackupHook hook);
+  /**
+   * @brief Schedules backup of already created db and state_db snapshots on snapshots worker
+   */
+  void scheduleSnapshotBackup(PbftPeriod period);
   void recoverToPeriod(PbftPeriod period);
   void loadSnapshots();
   void disableSnapshots();
@@ -223,8 +397,22 @@ class DbStorage : public std::enable_shared_from_this<DbStorage> {
 
   // Period data
   void savePeriodData(const PeriodData& period_data, Batch& write_batch);
+  /**
+   * @brief Schedules pruning of period data older than period and dag levels lower than dag_level_to_keep. Pruning
+   * runs on background worker in chunks, each chunk is committed atomically together with the persisted cursor so
+   * interrupted pruning continues from where it stopped
+   *
+   * @param period
+   * @param dag_level_to_keep
+   */
   void clearPeriodDataHistory(PbftPeriod period, uint64_t dag_level_to_keep);
+  /**
+   * @param rate_limit_mb IO rate limit of history pruning writes in MB/s, 0 means unlimited
+   */
+  void setPruningRateLimit(uint32_t rate_limit_mb);
+  PruningStats getPruningStats() const;
   dev::bytes getPeriodDataRaw(PbftPeriod period) const;
+  void addPeriodDataHeadToBatch(PbftPeriod period, const dev::RLP& period_data_rlp, Batch& write_batch);
   std::optional<PeriodData> getPeriodData(PbftPeriod period) const;
   std::optional<PbftBlock> getPbftBlock(PbftPeriod period) const;
   std::vector<std::shared_ptr<PbftVote>> getPeriodCertVotes(PbftPeriod period) const;
@@ -244,6 +432,14 @@ class DbStorage : public std::enable_shared_from_this<DbStorage> {
   // DAG
   void saveDagBlock(const std::shared_ptr<DagBlock>& blk, Batch* write_batch_p = nullptr);
   std::shared_ptr<DagBlock> getDagBlock(blk_hash_t const& hash);
+  /**
+   * @brief Gets dag blocks, finalized or non finalized, with batched db reads
+   *
+   * @param hashes
+   *
+   * @return Returns blocks in the order of provided hashes, nullptr for blocks not found
+   */
+  std::vector<std::shared_ptr<DagBlock>> getDagBlocks(std::vector<blk_hash_t> const& hashes);
   bool dagBlockInDb(blk_hash_t const& hash);
   std::set<blk_hash_t> getBlocksByLevel(level_t level);
   level_t getLastBlocksLevel() const;
@@ -259,7 +455,16 @@ class DbStorage : public std::enable_shared_from_this<DbStorage> {
 
   // Transaction
   std::shared_ptr<Transaction> getTransaction(trx_hash_t const& hash);
+  /**
+   * @brief Gets transactions, finalized or non finalized, with batched db reads
+   *
+   * @param trx_hashes
+   *
+   * @return Returns transactions in the order of provided hashes, nullptr for transactions not found
+   */
+  SharedTransactions getTransactions(std::vector<trx_hash_t> const& trx_hashes);
   SharedTransactions getAllNonfinalizedTransactions();
+  SharedTransactions getPoolJournalTransactions();
   bool transactionInDb(trx_hash_t const& hash);
   bool transactionFinalized(trx_hash_t const& hash);
   std::vector<bool> transactionsInDb(std::vector<trx_hash_t> const& trx_hashes);
@@ -270,6 +475,8 @@ class DbStorage : public std::enable_shared_from_this<DbStorage> {
   void addTransactionLocationToBatch(Batch& write_batch, trx_hash_t const& trx, PbftPeriod period, uint32_t position,
                                      bool is_system = false);
   std::optional<final_chain::TransactionLocation> getTransactionLocation(trx_hash_t const& hash) const;
+  std::vector<std::optional<final_chain::TransactionLocation>> getTransactionLocations(
+      std::vector<trx_hash_t> const& trx_hashes) const;
   std::unordered_map<trx_hash_t, PbftPeriod> getAllTransactionPeriod();
   uint64_t getTransactionCount(PbftPeriod period) const;
   /**
@@ -352,6 +559,15 @@ class DbStorage : public std::enable_shared_from_this<DbStorage> {
 
   std::vector<blk_hash_t> getFinalizedDagBlockHashesByPeriod(PbftPeriod period);
   std::vector<std::shared_ptr<DagBlock>> getFinalizedDagBlockByPeriod(PbftPeriod period);
+  /**
+   * @brief Gets finalized dag blocks of multiple periods with batched db reads
+   *
+   * @param periods
+   *
+   * @return Returns blocks of each period in the order of provided periods, empty vector for periods not found
+   */
+  std::vector<std::vector<std::shared_ptr<DagBlock>>> getFinalizedDagBlockByPeriods(
+      std::vector<PbftPeriod> const& periods);
   std::pair<blk_hash_t, std::vector<std::shared_ptr<DagBlock>>> getLastPbftBlockHashAndFinalizedDagBlockByPeriod(
       PbftPeriod period);
 
@@ -369,6 +585,10 @@ class DbStorage : public std::enable_shared_from_this<DbStorage> {
     return bytes((byte const*)b.data(), (byte const*)(b.data() + b.size()));
   }
 
+  inline static dev::bytesConstRef asBytesRef(Slice const& s) {
+    return dev::bytesConstRef(reinterpret_cast<byte const*>(s.data()), s.size());
+  }
+
   template <typename T>
   inline static Slice make_slice(T const* begin, size_t size) {
     if (!size) {
@@ -407,10 +627,12 @@ class DbStorage : public std::enable_shared_from_this<DbStorage> {
 
   inline static auto const& toSlices(std::vector<Slice> const& ss) { return ss; }
 
+  rocksdb::Status get(Column const& column, Slice const& key, std::string* value) const;
+
   template <typename K>
   std::string lookup(K const& key, Column const& column) const {
     std::string value;
-    auto status = db_->Get(read_options_, handle(column), toSlice(key), &value);
+    auto status = get(column, toSlice(key), &value);
     if (status.IsNotFound()) {
       return value;
     }
@@ -418,6 +640,60 @@ class DbStorage : public std::enable_shared_from_this<DbStorage> {
     return value;
   }
 
+  rocksdb::Status get(Column const& column, Slice const& key, rocksdb::PinnableSlice* value) const;
+
+  template <typename K>
+  PinnedValue lookupPinned(K const& key, Column const& column) const {
+    PinnedValue value;
+    auto status = get(column, toSlice(key), &value.value_);
+    if (!status.IsNotFound()) {
+      checkStatus(status);
+    }
+    return value;
+  }
+
+  /**
+   * @brief Looks up the key and decodes the value straight from the pinned db buffer
+   *
+   * @param key
+   * @param column
+   *
+   * @return Returns decoded value or nullptr if key is not found
+   */
+  template <typename T, typename K>
+  std::shared_ptr<T> lookup(K const& key, TypedColumn<T> const& column) const {
+    const auto value = lookupPinned(key, column.column);
+    if (value.empty()) {
+      return nullptr;
+    }
+    return std::make_shared<T>(value.rlp());
+  }
+
+  /**
+   * @brief Decodes the value of an iterator entry of the typed column without copying it
+   */
+  template <typename T>
+  static std::shared_ptr<T> decode(Slice const& value, TypedColumn<T> const&) {
+    return std::make_shared<T>(dev::RLP(asBytesRef(value)));
+  }
+
+  void multiGet(Column const& column, std::vector<Slice> const& keys, std::vector<PinnedValue>& values) const;
+
+  /**
+   * @brief Looks up multiple keys of the column with a single MultiGet
+   *
+   * @param keys
+   * @param column
+   *
+   * @return Returns values in the order of provided keys, empty values for keys not found
+   */
+  template <typename K>
+  std::vector<PinnedValue> multiLookup(std::vector<K> const& keys, Column const& column) const {
+    std::vector<PinnedValue> values;
+    multiGet(column, toSlices(keys), values);
+    return values;
+  }
+
   template <typename Int, typename K>
   auto lookup_int(K const& key, Column const& column) -> std::enable_if_t<std::is_integral_v<Int>, std::optional<Int>> {
     auto str = lookup(key, column);
@@ -432,7 +708,7 @@ class DbStorage : public std::enable_shared_from_this<DbStorage> {
     std::string value;
     // KeyMayExist can lead to a few false positives, but not false negatives.
     if (db_->KeyMayExist(read_options_, handle(column), toSlice(key), &value)) {
-      auto status = db_->Get(read_options_, handle(column), toSlice(key), &value);
+      auto status = get(column, toSlice(key), &value);
       if (status.IsNotFound()) {
         return false;
       }
@@ -2,12 +2,14 @@
 
 #include "storage/migration/final_chain_header.hpp"
 #include "storage/migration/period_dag_blocks.hpp"
+#include "storage/migration/period_data_head.hpp"
 #include "storage/migration/transaction_period.hpp"
 namespace taraxa::storage::migration {
 
 Manager::Manager(std::shared_ptr<DbStorage> db, const addr_t& node_addr) : db_(db) {
   registerMigration<PeriodDagBlocks>();
   registerMigration<FinalChainHeader>();
+  registerMigration<PeriodDataHead>();
   LOG_OBJECTS_CREATE("MIGRATIONS");
 }
 void Manager::applyMigration(std::shared_ptr<migration::Base> m) {
@@ -0,0 +1,34 @@
+#include "storage/migration/period_data_head.hpp"
+
+#include <cstdint>
+
+namespace taraxa::storage::migration {
+
+PeriodDataHead::PeriodDataHead(std::shared_ptr<DbStorage> db) : migration::Base(db) {}
+
+std::string PeriodDataHead::id() { return "PeriodDataHead"; }
+
+uint32_t PeriodDataHead::dbVersion() { return 1; }
+
+void PeriodDataHead::migrate(logger::Logger& log) {
+  auto it = db_->getColumnIterator(DbStorage::Columns::period_data);
+  it->SeekToFirst();
+  if (!it->Valid()) {
+    return;
+  }
+
+  const size_t max_size = 500000000;
+  uint64_t count = 0;
+  for (; it->Valid(); it->Next()) {
+    PbftPeriod period;
+    memcpy(&period, it->key().data(), sizeof(PbftPeriod));
+    db_->addPeriodDataHeadToBatch(period, dev::RLP(DbStorage::asBytesRef(it->value())), batch_);
+    if (batch_.GetDataSize() > max_size) {
+      db_->commitWriteBatch(batch_);
+    }
+    if (++count % 100000 == 0) {
+      LOG(log) << "Migration " << id() << " processed " << count << " periods";
+    }
+  }
+}
+}  // namespace taraxa::storage::migration
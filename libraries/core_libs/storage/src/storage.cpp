@@ -3,15 +3,27 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/split.hpp>
 #include <cstdint>
+#include <fstream>
+#include <libdevcore/SHA3.h>
 #include <memory>
+#include <numeric>
 #include <regex>
 
+#include "common/jsoncpp.hpp"
 #include "config/version.hpp"
 #include "dag/dag_block_bundle_rlp.hpp"
 #include "dag/sortition_params_manager.hpp"
 #include "final_chain/data.hpp"
 #include "pillar_chain/pillar_block.hpp"
+#include "rocksdb/filter_policy.h"
+#include "rocksdb/perf_context.h"
+#include "rocksdb/perf_level.h"
+#include "rocksdb/rate_limiter.h"
+#include "rocksdb/slice_transform.h"
+#include "rocksdb/statistics.h"
+#include "rocksdb/table.h"
 #include "rocksdb/utilities/checkpoint.h"
+#include "rocksdb/utilities/table_properties_collectors.h"
 #include "storage/uint_comparator.hpp"
 #include "transaction/system_transaction.hpp"
 #include "vote/pbft_vote.hpp"
@@ -27,12 +39,40 @@ static constexpr uint16_t TRANSACTIONS_POS_IN_PERIOD_DATA = 3;
 static constexpr uint16_t PILLAR_VOTES_POS_IN_PERIOD_DATA = 4;
 static constexpr uint16_t PREV_BLOCK_HASH_POS_IN_PBFT_BLOCK = 0;
 
+// Pruned columns whose keys are not ordered by period, so they can't be deleted with range tombstones
+static const std::set<std::string> kHashKeyedPrunedColumns = {
+    "final_chain_receipt_by_trx_hash", "pbft_block_period",           "final_chain_log_blooms_index",
+    "dag_block_period",                "final_chain_blk_by_number",   "final_chain_blk_hash_by_number",
+    "final_chain_blk_number_by_hash"};
+// Sst file is marked for compaction once it has kDeletionCompactionTrigger tombstones within kDeletionCompactionWindow
+// consecutive entries
+static constexpr size_t kDeletionCompactionWindow = 10000;
+static constexpr size_t kDeletionCompactionTrigger = 2000;
+
+static rocksdb::CompressionType toCompressionType(const std::string& name) {
+  static const std::unordered_map<std::string, rocksdb::CompressionType> kCompressions = {
+      {"none", rocksdb::CompressionType::kNoCompression},
+      {"snappy", rocksdb::CompressionType::kSnappyCompression},
+      {"lz4", rocksdb::CompressionType::kLZ4Compression},
+      {"lz4hc", rocksdb::CompressionType::kLZ4HCCompression},
+      {"zstd", rocksdb::CompressionType::kZSTD}};
+
+  const auto it = kCompressions.find(name);
+  if (it == kCompressions.end()) {
+    throw DbException("Unsupported db compression type: " + name);
+  }
+  return it->second;
+}
+
 DbStorage::DbStorage(fs::path const& path, uint32_t db_snapshot_each_n_pbft_block, uint32_t max_open_files,
-                     uint32_t db_max_snapshots, PbftPeriod db_revert_to_period, addr_t node_addr, bool rebuild)
+                     uint32_t db_max_snapshots, PbftPeriod db_revert_to_period, addr_t node_addr, bool rebuild,
+                     const RocksDbConfig& rocksdb_config)
     : path_(path),
       handles_(Columns::all.size()),
+      columns_cache_counters_(Columns::all.size()),
       kDbSnapshotsEachNblock(db_snapshot_each_n_pbft_block),
-      kDbSnapshotsMaxCount(db_max_snapshots) {
+      kDbSnapshotsMaxCount(db_max_snapshots),
+      kRocksDbConfig(rocksdb_config) {
   db_path_ = (path / kDbDir);
   state_db_path_ = (path / kStateDbDir);
 
@@ -62,12 +102,20 @@ DbStorage::DbStorage(fs::path const& path, uint32_t db_snapshot_each_n_pbft_bloc
   // aleth default 256 (state_db is using another 128)
   options.max_open_files = (max_open_files) ? max_open_files : 256;
 
+  initColumnsOptions();
+  options.row_cache = row_cache_;
+  if (kRocksDbConfig.statistics) {
+    statistics_ = rocksdb::CreateDBStatistics();
+    statistics_->set_stats_level(rocksdb::StatsLevel::kExceptTimers);
+    options.statistics = statistics_;
+  }
+  // Only effective when rocksdb is built with io_uring support, falls back to synchronous reads otherwise
+  multi_get_read_options_.async_io = true;
+
   std::vector<rocksdb::ColumnFamilyDescriptor> descriptors;
   descriptors.reserve(Columns::all.size());
-  std::transform(Columns::all.begin(), Columns::all.end(), std::back_inserter(descriptors), [](const Column& col) {
-    auto options = rocksdb::ColumnFamilyOptions();
-    if (col.comparator_) options.comparator = col.comparator_;
-    return rocksdb::ColumnFamilyDescriptor(col.name(), options);
+  std::transform(Columns::all.begin(), Columns::all.end(), std::back_inserter(descriptors), [this](const Column& col) {
+    return rocksdb::ColumnFamilyDescriptor(col.name(), columns_options_[col.ordinal_]);
   });
 
   rebuildColumns(options);
@@ -96,6 +144,210 @@ DbStorage::DbStorage(fs::path const& path, uint32_t db_snapshot_each_n_pbft_bloc
   }
 }
 
+void DbStorage::initColumnsOptions() {
+  columns_options_.resize(Columns::all.size());
+
+  for (const auto& [column_name, _] : kRocksDbConfig.columns) {
+    if (std::find_if(Columns::all.begin(), Columns::all.end(),
+                     [&column_name](const Column& col) { return col.name() == column_name; }) == Columns::all.end()) {
+      LOG(log_wr_) << "Db profile is configured for unknown column " << column_name;
+    }
+  }
+
+  if (kRocksDbConfig.block_cache_mb) {
+    shared_block_cache_ = rocksdb::NewLRUCache(static_cast<size_t>(kRocksDbConfig.block_cache_mb) * 1024 * 1024);
+  }
+  if (kRocksDbConfig.row_cache_mb) {
+    row_cache_ = rocksdb::NewLRUCache(static_cast<size_t>(kRocksDbConfig.row_cache_mb) * 1024 * 1024);
+  }
+
+  for (const auto& col : Columns::all) {
+    auto& options = columns_options_[col.ordinal_];
+    if (col.comparator_) options.comparator = col.comparator_;
+    // Sst files of these columns with many tombstones get compacted by rocksdb instead of compacting the whole
+    // column after pruning
+    if (kHashKeyedPrunedColumns.contains(col.name())) {
+      options.table_properties_collector_factories.emplace_back(
+          rocksdb::NewCompactOnDeletionCollectorFactory(kDeletionCompactionWindow, kDeletionCompactionTrigger));
+    }
+
+    const auto profile_it = kRocksDbConfig.columns.find(col.name());
+    if (profile_it == kRocksDbConfig.columns.end()) {
+      // Columns without profile use default table options, only block cache is shared if configured
+      if (shared_block_cache_) {
+        rocksdb::BlockBasedTableOptions table_options;
+        table_options.block_cache = shared_block_cache_;
+        options.table_factory.reset(rocksdb::NewBlockBasedTableFactory(table_options));
+      }
+      continue;
+    }
+    const auto& profile_name = profile_it->second;
+    const auto& profile = kRocksDbConfig.profiles.at(profile_name);
+
+    rocksdb::BlockBasedTableOptions table_options;
+    if (profile.bloom_bits_per_key) {
+      table_options.filter_policy.reset(rocksdb::NewBloomFilterPolicy(profile.bloom_bits_per_key));
+    }
+    if (profile.block_size_kb) {
+      table_options.block_size = static_cast<size_t>(profile.block_size_kb) * 1024;
+    }
+    // Columns with the same profile share single block cache, profiles without own cache use the shared one
+    if (profile.block_cache_mb) {
+      auto& cache = profiles_block_caches_[profile_name];
+      if (!cache) {
+        cache = rocksdb::NewLRUCache(static_cast<size_t>(profile.block_cache_mb) * 1024 * 1024);
+      }
+      table_options.block_cache = cache;
+    } else if (shared_block_cache_) {
+      table_options.block_cache = shared_block_cache_;
+    }
+    options.table_factory.reset(rocksdb::NewBlockBasedTableFactory(table_options));
+
+    if (!profile.compression_per_level.empty()) {
+      std::transform(profile.compression_per_level.begin(), profile.compression_per_level.end(),
+                     std::back_inserter(options.compression_per_level), toCompressionType);
+    }
+
+    if (profile.prefix_length) {
+      options.prefix_extractor.reset(rocksdb::NewFixedPrefixTransform(profile.prefix_length));
+      options.memtable_prefix_bloom_size_ratio = 0.1;
+    }
+
+    LOG(log_nf_) << "Db column " << col.name() << " uses profile " << profile_name;
+  }
+}
+
+rocksdb::ColumnFamilyOptions DbStorage::getColumnOptions(const std::string& column_name) const {
+  const auto it = std::find_if(Columns::all.begin(), Columns::all.end(),
+                               [&column_name](const Column& col) { return col.name() == column_name; });
+  if (it == Columns::all.end()) {
+    return rocksdb::ColumnFamilyOptions();
+  }
+  return columns_options_[it->ordinal_];
+}
+
+std::vector<DbStorage::ColumnStats> DbStorage::getColumnsStats() const {
+  std::vector<ColumnStats> stats;
+  stats.reserve(Columns::all.size());
+  for (const auto& col : Columns::all) {
+    auto& col_stats = stats.emplace_back();
+    col_stats.column = col.name();
+    if (const auto profile_it = kRocksDbConfig.columns.find(col.name()); profile_it != kRocksDbConfig.columns.end()) {
+      col_stats.profile = profile_it->second;
+      col_stats.bloom_bits_per_key = kRocksDbConfig.profiles.at(profile_it->second).bloom_bits_per_key;
+    }
+
+    const auto table_options =
+        columns_options_[col.ordinal_].table_factory->GetOptions<rocksdb::BlockBasedTableOptions>();
+    if (table_options) {
+      col_stats.block_size = table_options->block_size;
+      if (table_options->block_cache) {
+        col_stats.block_cache_capacity = table_options->block_cache->GetCapacity();
+        col_stats.block_cache_usage = table_options->block_cache->GetUsage();
+      }
+    }
+
+    col_stats.block_cache_hit = columns_cache_counters_[col.ordinal_].hit.load(std::memory_order_relaxed);
+    col_stats.block_cache_miss = columns_cache_counters_[col.ordinal_].miss.load(std::memory_order_relaxed);
+
+    db_->GetIntProperty(handle(col), rocksdb::DB::Properties::kEstimateNumKeys, &col_stats.estimate_num_keys);
+    db_->GetIntProperty(handle(col), rocksdb::DB::Properties::kLiveSstFilesSize, &col_stats.live_sst_files_size);
+  }
+  return stats;
+}
+
+DbStorage::CacheStats DbStorage::getCacheStats() const {
+  CacheStats stats;
+  if (shared_block_cache_) {
+    stats.block_cache_capacity = shared_block_cache_->GetCapacity();
+    stats.block_cache_usage = shared_block_cache_->GetUsage();
+    stats.block_cache_pinned_usage = shared_block_cache_->GetPinnedUsage();
+  }
+  if (row_cache_) {
+    stats.row_cache_capacity = row_cache_->GetCapacity();
+    stats.row_cache_usage = row_cache_->GetUsage();
+  }
+
+  if (statistics_) {
+    stats.block_cache_hit = statistics_->getTickerCount(rocksdb::Tickers::BLOCK_CACHE_HIT);
+    stats.block_cache_miss = statistics_->getTickerCount(rocksdb::Tickers::BLOCK_CACHE_MISS);
+    stats.row_cache_hit = statistics_->getTickerCount(rocksdb::Tickers::ROW_CACHE_HIT);
+    stats.row_cache_miss = statistics_->getTickerCount(rocksdb::Tickers::ROW_CACHE_MISS);
+  }
+  return stats;
+}
+
+rocksdb::Status DbStorage::get(Column const& column, Slice const& key, std::string* value) const {
+  rocksdb::Status status;
+  countColumnCacheAccess(column, [&] { status = db_->Get(read_options_, handle(column), key, value); });
+  return status;
+}
+
+rocksdb::Status DbStorage::get(Column const& column, Slice const& key, rocksdb::PinnableSlice* value) const {
+  rocksdb::Status status;
+  countColumnCacheAccess(column, [&] { status = db_->Get(read_options_, handle(column), key, value); });
+  return status;
+}
+
+void DbStorage::multiGet(Column const& column, std::vector<Slice> const& keys, std::vector<PinnedValue>& values) const {
+  values.clear();
+  values.resize(keys.size());
+  if (keys.empty()) {
+    return;
+  }
+
+  // Keys are passed to MultiGet sorted by the column comparator so rocksdb doesn't need to sort them again
+  auto cf = handle(column);
+  const auto* comparator = cf->GetComparator();
+  std::vector<size_t> order(keys.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&](size_t a, size_t b) { return comparator->Compare(keys[a], keys[b]) < 0; });
+  std::vector<Slice> sorted_keys;
+  sorted_keys.reserve(keys.size());
+  for (auto i : order) {
+    sorted_keys.emplace_back(keys[i]);
+  }
+
+  std::vector<rocksdb::PinnableSlice> pinned_values(keys.size());
+  std::vector<rocksdb::Status> statuses(keys.size());
+  countColumnCacheAccess(column, [&] {
+    db_->MultiGet(multi_get_read_options_, cf, keys.size(), sorted_keys.data(), pinned_values.data(), statuses.data(),
+                  true);
+  });
+
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (statuses[i].IsNotFound()) {
+      continue;
+    }
+    checkStatus(statuses[i]);
+    values[order[i]].value_ = std::move(pinned_values[i]);
+  }
+}
+
+void DbStorage::countColumnCacheAccess(Column const& column, const std::function<void()>& read) const {
+  if (!statistics_) {
+    read();
+    return;
+  }
+
+  // Perf context is thread local, block cache counters are used to attribute hits and misses to the column
+  thread_local bool perf_level_set = false;
+  if (!perf_level_set) {
+    rocksdb::SetPerfLevel(rocksdb::PerfLevel::kEnableCount);
+    perf_level_set = true;
+  }
+  const auto* perf_context = rocksdb::get_perf_context();
+  const auto hit_before = perf_context->block_cache_hit_count;
+  const auto miss_before = perf_context->block_cache_miss_count;
+
+  read();
+
+  auto& counters = columns_cache_counters_[column.ordinal_];
+  counters.hit.fetch_add(perf_context->block_cache_hit_count - hit_before, std::memory_order_relaxed);
+  counters.miss.fetch_add(perf_context->block_cache_miss_count - miss_before, std::memory_order_relaxed);
+}
+
 void DbStorage::removeTempFiles() const {
   const std::regex filePattern("LOG\\.old\\.\\d+");
   removeFilesWithPattern(db_path_, filePattern);
@@ -168,7 +420,7 @@ std::unique_ptr<rocksdb::ColumnFamilyHandle> DbStorage::copyColumn(rocksdb::Colu
   checkStatus(status);
 
   const rocksdb::Comparator* comparator = orig_column->GetComparator();
-  auto options = rocksdb::ColumnFamilyOptions();
+  auto options = getColumnOptions(new_col_name);
   if (comparator != nullptr) {
     options.comparator = comparator;
   }
@@ -209,11 +461,7 @@ void DbStorage::deleteColumnData(const Column& c) {
   checkStatus(db_->DropColumnFamily(handle(c)));
   db_->DestroyColumnFamilyHandle(handle(c));
 
-  auto options = rocksdb::ColumnFamilyOptions();
-  if (c.comparator_) {
-    options.comparator = c.comparator_;
-  }
-  checkStatus(db_->CreateColumnFamily(options, c.name(), &handles_[c.ordinal_]));
+  checkStatus(db_->CreateColumnFamily(columns_options_[c.ordinal_], c.name(), &handles_[c.ordinal_]));
 }
 
 void DbStorage::rebuildColumns(const rocksdb::Options& options) {
@@ -229,15 +477,16 @@ void DbStorage::rebuildColumns(const rocksdb::Options& options) {
   descriptors.reserve(column_families.size());
   std::vector<rocksdb::ColumnFamilyHandle*> handles;
   handles.reserve(column_families.size());
-  std::transform(column_families.begin(), column_families.end(), std::back_inserter(descriptors), [](const auto& name) {
-    const auto it = std::find_if(Columns::all.begin(), Columns::all.end(), [&name](const Column& col) {
-      // "-copy" is there, so we will removed unsuccessful migrations
-      return col.name() == name || col.name() + "-copy" == name;
-    });
-    auto options = rocksdb::ColumnFamilyOptions();
-    if (it != Columns::all.end() && it->comparator_) options.comparator = it->comparator_;
-    return rocksdb::ColumnFamilyDescriptor(name, options);
-  });
+  std::transform(column_families.begin(), column_families.end(), std::back_inserter(descriptors),
+                 [this](const auto& name) {
+                   const auto it = std::find_if(Columns::all.begin(), Columns::all.end(), [&name](const Column& col) {
+                     // "-copy" is there, so we will removed unsuccessful migrations
+                     return col.name() == name || col.name() + "-copy" == name;
+                   });
+                   auto options = rocksdb::ColumnFamilyOptions();
+                   if (it != Columns::all.end()) options = columns_options_[it->ordinal_];
+                   return rocksdb::ColumnFamilyDescriptor(name, options);
+                 });
   rocksdb::DB* db_ptr = nullptr;
   checkStatus(rocksdb::DB::Open(options, db_path_.string(), descriptors, &handles, &db_ptr));
   assert(db_ptr);
@@ -299,10 +548,14 @@ void DbStorage::loadSnapshots() {
   }
 }
 
-bool DbStorage::createSnapshot(PbftPeriod period) {
+bool DbStorage::isSnapshotPeriod(PbftPeriod period) const {
   // Only creates snapshot each kDbSnapshotsEachNblock periods
-  if (!snapshots_enabled_ || kDbSnapshotsEachNblock <= 0 || period % kDbSnapshotsEachNblock != 0 ||
-      snapshots_.find(period) != snapshots_.end()) {
+  return snapshots_enabled_ && kDbSnapshotsEachNblock > 0 && period % kDbSnapshotsEachNblock == 0 &&
+         snapshots_.find(period) == snapshots_.end();
+}
+
+bool DbStorage::createSnapshot(PbftPeriod period) {
+  if (!isSnapshotPeriod(period)) {
     return false;
   }
 
@@ -321,17 +574,158 @@ bool DbStorage::createSnapshot(PbftPeriod period) {
   checkStatus(status);
   snapshots_.insert(period);
 
-  // Delete any snapshot over kDbSnapshotsMaxCount
+  // Delete any snapshot over kDbSnapshotsMaxCount, removing directories is slow so it is done on snapshots worker
   if (kDbSnapshotsMaxCount && snapshots_.size() > kDbSnapshotsMaxCount) {
     while (snapshots_.size() > kDbSnapshotsMaxCount) {
       auto snapshot = snapshots_.begin();
-      deleteSnapshot(*snapshot);
+      snapshots_worker_.post([this, period = *snapshot] { deleteSnapshot(period); });
       snapshots_.erase(snapshot);
     }
   }
   return true;
 }
 
+void DbStorage::enableSnapshotsBackup(const fs::path& backup_path, uint32_t rate_limit_mb) {
+  snapshots_backup_path_ = backup_path;
+  if (rate_limit_mb) {
+    snapshots_backup_rate_limiter_.reset(
+        rocksdb::NewGenericRateLimiter(static_cast<int64_t>(rate_limit_mb) * 1024 * 1024));
+  }
+  LOG(log_nf_) << "DB snapshots backup enabled to " << backup_path;
+}
+
+void DbStorage::setSnapshotBackupHook(SnapshotBackupHook hook) { snapshot_backup_hook_ = std::move(hook); }
+
+void DbStorage::scheduleSnapshotBackup(PbftPeriod period) {
+  if (snapshots_backup_path_.empty()) {
+    return;
+  }
+  snapshots_worker_.post([this, period] { backupSnapshot(period); });
+}
+
+void DbStorage::backupSnapshot(PbftPeriod period) {
+  auto db_snapshot_path = db_path_;
+  auto state_db_snapshot_path = state_db_path_;
+  db_snapshot_path += std::to_string(period);
+  state_db_snapshot_path += std::to_string(period);
+
+  try {
+    Json::Value manifest(Json::objectValue);
+    manifest["period"] = Json::UInt64(period);
+    manifest[kDbDir] = backupSnapshotDir(db_snapshot_path, snapshots_backup_path_ / "shared" / kDbDir,
+                                         snapshots_backup_path_ / (kDbDir + std::to_string(period)));
+    manifest[kStateDbDir] =
+        backupSnapshotDir(state_db_snapshot_path, snapshots_backup_path_ / "shared" / kStateDbDir,
+                          snapshots_backup_path_ / (kStateDbDir + std::to_string(period)));
+
+    const auto manifest_path = snapshots_backup_path_ / ("snapshot" + std::to_string(period) + ".json");
+    // Manifest is renamed into place, so it is never seen partially written
+    auto manifest_tmp_path = manifest_path;
+    manifest_tmp_path += ".tmp";
+    util::writeJsonToFile(manifest_tmp_path.string(), manifest);
+    fs::rename(manifest_tmp_path, manifest_path);
+    LOG(log_nf_) << "DB snapshot " << period << " backed up, manifest " << manifest_path;
+
+    if (snapshot_backup_hook_) {
+      snapshot_backup_hook_worker_.post([this, period, manifest_path] {
+        try {
+          snapshot_backup_hook_(period, manifest_path);
+        } catch (const std::exception& e) {
+          LOG(log_er_) << "DB snapshot " << period << " backup hook failed: " << e.what();
+        }
+      });
+    }
+  } catch (const std::exception& e) {
+    LOG(log_er_) << "DB snapshot " << period << " backup failed: " << e.what();
+  }
+}
+
+Json::Value DbStorage::backupSnapshotDir(const fs::path& snapshot_path, const fs::path& shared_path,
+                                         const fs::path& backup_path) {
+  Json::Value manifest(Json::objectValue);
+  manifest["shared"] = Json::Value(Json::arrayValue);
+  manifest["added"] = Json::Value(Json::arrayValue);
+  manifest["files"] = Json::Value(Json::arrayValue);
+  fs::create_directories(shared_path);
+  fs::create_directories(backup_path);
+
+  for (const auto& entry : fs::directory_iterator(snapshot_path)) {
+    if (!entry.is_regular_file()) {
+      continue;
+    }
+    const auto name = entry.path().filename().string();
+    if (entry.path().extension() != ".sst") {
+      manifest["files"].append(name);
+      copyFileRateLimited(entry.path(), backup_path / name);
+      continue;
+    }
+
+    // Sst files are immutable, so file shared by consecutive snapshots is stored in backup only once. Stored name
+    // includes file id, so a different file with the same name never replaces file of older snapshots
+    const auto shared_name = entry.path().stem().string() + "-" + sstFileId(entry.path()) + ".sst";
+    Json::Value shared_entry(Json::objectValue);
+    shared_entry["name"] = name;
+    shared_entry["shared"] = shared_name;
+    manifest["shared"].append(shared_entry);
+    const auto shared_file = shared_path / shared_name;
+    if (fs::exists(shared_file) && fs::file_size(shared_file) == entry.file_size()) {
+      continue;
+    }
+    manifest["added"].append(shared_name);
+    fs::remove(shared_file);
+    // Hard link when backup is on the same filesystem, otherwise copy
+    std::error_code ec;
+    fs::create_hard_link(entry.path(), shared_file, ec);
+    if (ec) {
+      copyFileRateLimited(entry.path(), shared_file);
+    }
+  }
+  return manifest;
+}
+
+std::string DbStorage::sstFileId(const fs::path& path) {
+  // File name is only a file number, which is reused by rebuilt db. Table properties with db session id and original
+  // file number are written right before the footer, so the tail of sst file identifies it
+  constexpr size_t kTailSize = 64 * 1024;
+  const auto size = fs::file_size(path);
+  const auto tail_size = std::min<size_t>(kTailSize, size);
+  dev::bytes tail(tail_size);
+  std::ifstream in(path, std::ios::binary);
+  in.seekg(static_cast<std::streamoff>(size - tail_size));
+  in.read(reinterpret_cast<char*>(tail.data()), static_cast<std::streamsize>(tail_size));
+  if (in.gcount() != static_cast<std::streamsize>(tail_size)) {
+    throw std::runtime_error("Failed to read " + path.string());
+  }
+  return dev::sha3(tail).hex().substr(0, 16);
+}
+
+void DbStorage::copyFileRateLimited(const fs::path& from, const fs::path& to) {
+  if (!snapshots_backup_rate_limiter_) {
+    fs::copy_file(from, to, fs::copy_options::overwrite_existing);
+    return;
+  }
+
+  constexpr size_t kMaxChunkSize = 1024 * 1024;
+  const auto chunk_size =
+      std::min<size_t>(kMaxChunkSize, static_cast<size_t>(snapshots_backup_rate_limiter_->GetSingleBurstBytes()));
+  std::vector<char> buffer(chunk_size);
+  std::ifstream in(from, std::ios::binary);
+  std::ofstream out(to, std::ios::binary | std::ios::trunc);
+  while (in) {
+    in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    const auto read = in.gcount();
+    if (read <= 0) {
+      break;
+    }
+    snapshots_backup_rate_limiter_->Request(read, rocksdb::Env::IO_LOW, nullptr,
+                                            rocksdb::RateLimiter::OpType::kWrite);
+    out.write(buffer.data(), read);
+  }
+  if (!out) {
+    throw std::runtime_error("Failed to copy " + from.string() + " to " + to.string());
+  }
+}
+
 void DbStorage::recoverToPeriod(PbftPeriod period) {
   LOG(log_nf_) << "Revet to snapshot from period: " << period;
 
@@ -399,6 +793,14 @@ std::optional<h256> DbStorage::getGenesisHash() {
 }
 
 DbStorage::~DbStorage() {
+  {
+    std::unique_lock lock(pruning_mutex_);
+    pruning_stopped_ = true;
+  }
+  pruning_cv_.notify_all();
+  pruning_worker_.stop();
+  snapshots_worker_.stop();
+  snapshot_backup_hook_worker_.stop();
   for (auto cf : handles_) {
     if (cf->GetName() != "default") {
       checkStatus(db_->DestroyColumnFamilyHandle(cf));
@@ -432,22 +834,68 @@ void DbStorage::commitWriteBatch(Batch& write_batch, rocksdb::WriteOptions const
 }
 
 std::shared_ptr<DagBlock> DbStorage::getDagBlock(blk_hash_t const& hash) {
-  auto block_data = asBytes(lookup(toSlice(hash.asBytes()), Columns::dag_blocks));
-  if (block_data.size() > 0) {
-    return std::make_shared<DagBlock>(block_data);
+  if (auto block = lookup(hash, TypedColumns::dag_blocks)) {
+    return block;
   }
   auto data = getDagBlockPeriod(hash);
   if (data) {
-    auto period_data = getPeriodDataRaw(data->first);
-    if (period_data.size() > 0) {
-      auto period_data_rlp = dev::RLP(period_data);
-      auto dag_blocks_data = period_data_rlp[DAG_BLOCKS_POS_IN_PERIOD_DATA];
+    const auto period_data = lookupPinned(data->first, Columns::period_data);
+    if (!period_data.empty()) {
+      auto dag_blocks_data = period_data.rlp()[DAG_BLOCKS_POS_IN_PERIOD_DATA];
       return decodeDAGBlockBundleRlp(data->second, dag_blocks_data);
     }
   }
   return nullptr;
 }
 
+std::vector<std::shared_ptr<DagBlock>> DbStorage::getDagBlocks(std::vector<blk_hash_t> const& hashes) {
+  std::vector<std::shared_ptr<DagBlock>> blocks(hashes.size());
+  const auto blocks_data = multiLookup(hashes, Columns::dag_blocks);
+
+  // Blocks which are not in dag_blocks column are finalized and stored in period data
+  std::vector<size_t> finalized_idx;
+  std::vector<blk_hash_t> finalized_hashes;
+  for (size_t i = 0; i < hashes.size(); ++i) {
+    if (!blocks_data[i].empty()) {
+      blocks[i] = std::make_shared<DagBlock>(blocks_data[i].rlp());
+    } else {
+      finalized_idx.push_back(i);
+      finalized_hashes.push_back(hashes[i]);
+    }
+  }
+  if (finalized_hashes.empty()) {
+    return blocks;
+  }
+
+  const auto locations_data = multiLookup(finalized_hashes, Columns::dag_block_period);
+  // Map of period to (index in result, position of block within a period)
+  std::map<PbftPeriod, std::vector<std::pair<size_t, uint32_t>>> period_map;
+  for (size_t i = 0; i < finalized_hashes.size(); ++i) {
+    if (locations_data[i].empty()) {
+      continue;
+    }
+    const auto rlp = locations_data[i].rlp();
+    period_map[rlp[0].toInt<PbftPeriod>()].emplace_back(finalized_idx[i], rlp[1].toInt<uint32_t>());
+  }
+
+  std::vector<PbftPeriod> periods;
+  periods.reserve(period_map.size());
+  for (const auto& it : period_map) {
+    periods.push_back(it.first);
+  }
+  const auto periods_data = multiLookup(periods, Columns::period_data);
+  for (size_t i = 0; i < periods.size(); ++i) {
+    if (periods_data[i].empty()) {
+      continue;
+    }
+    const auto dag_blocks_data = periods_data[i].rlp()[DAG_BLOCKS_POS_IN_PERIOD_DATA];
+    for (const auto& [idx, pos] : period_map[periods[i]]) {
+      blocks[idx] = decodeDAGBlockBundleRlp(pos, dag_blocks_data);
+    }
+  }
+  return blocks;
+}
+
 bool DbStorage::dagBlockInDb(blk_hash_t const& hash) {
   if (exist(toSlice(hash.asBytes()), Columns::dag_blocks) ||
       exist(toSlice(hash.asBytes()), Columns::dag_block_period)) {
@@ -476,11 +924,10 @@ std::vector<std::shared_ptr<DagBlock>> DbStorage::getDagBlocksAtLevel(level_t le
   std::vector<std::shared_ptr<DagBlock>> res;
   for (int i = 0; i < number_of_levels; i++) {
     if (level + i == 0) continue;  // Skip genesis
-    auto block_hashes = getBlocksByLevel(level + i);
-    for (auto const& hash : block_hashes) {
-      auto blk = getDagBlock(hash);
+    const auto block_hashes = getBlocksByLevel(level + i);
+    for (auto& blk : getDagBlocks({block_hashes.begin(), block_hashes.end()})) {
       if (blk) {
-        res.push_back(blk);
+        res.push_back(std::move(blk));
       }
     }
   }
@@ -491,7 +938,7 @@ std::map<level_t, std::vector<std::shared_ptr<DagBlock>>> DbStorage::getNonfinal
   std::map<level_t, std::vector<std::shared_ptr<DagBlock>>> res;
   auto i = std::unique_ptr<rocksdb::Iterator>(db_->NewIterator(read_options_, handle(Columns::dag_blocks)));
   for (i->SeekToFirst(); i->Valid(); i->Next()) {
-    auto block = std::make_shared<DagBlock>(asBytes(i->value().ToString()));
+    auto block = decode(i->value(), TypedColumns::dag_blocks);
     res[block->getLevel()].emplace_back(std::move(block));
   }
   return res;
@@ -501,7 +948,16 @@ SharedTransactions DbStorage::getAllNonfinalizedTransactions() {
   SharedTransactions res;
   auto i = std::unique_ptr<rocksdb::Iterator>(db_->NewIterator(read_options_, handle(Columns::transactions)));
   for (i->SeekToFirst(); i->Valid(); i->Next()) {
-    res.emplace_back(std::make_shared<Transaction>(asBytes(i->value().ToString())));
+    res.emplace_back(decode(i->value(), TypedColumns::transactions));
+  }
+  return res;
+}
+
+SharedTransactions DbStorage::getPoolJournalTransactions() {
+  SharedTransactions res;
+  auto i = getColumnIterator(Columns::transactions_pool_journal);
+  for (i->SeekToFirst(); i->Valid(); i->Next()) {
+    res.emplace_back(decode(i->value(), TypedColumns::transactions));
   }
   return res;
 }
@@ -591,32 +1047,107 @@ std::optional<SortitionParamsChange> DbStorage::getParamsChangeForPeriod(PbftPer
 }
 
 void DbStorage::clearPeriodDataHistory(PbftPeriod end_period, uint64_t dag_level_to_keep) {
-  LOG(log_si_) << "Clear light node history";
-  auto it = std::unique_ptr<rocksdb::Iterator>(db_->NewIterator(read_options_, handle(Columns::period_data)));
-  // Find the first non-deleted period
-  it->SeekToFirst();
-  if (!it->Valid()) {
+  std::unique_lock lock(pruning_mutex_);
+  pruning_target_.period = std::max(pruning_target_.period, end_period);
+  pruning_target_.dag_level = std::max(pruning_target_.dag_level, dag_level_to_keep);
+  if (pruning_scheduled_ || pruning_target_ == pruning_done_target_) {
     return;
   }
+  pruning_scheduled_ = true;
+  pruning_worker_.post([this] { pruneHistory(); });
+}
 
-  uint64_t start_period;
-  memcpy(&start_period, it->key().data(), sizeof(uint64_t));
-  it = std::unique_ptr<rocksdb::Iterator>(db_->NewIterator(read_options_, handle(Columns::dag_blocks_level)));
-  it->SeekToFirst();
-  if (!it->Valid()) {
+void DbStorage::setPruningRateLimit(uint32_t rate_limit_mb) {
+  if (rate_limit_mb) {
+    pruning_rate_limiter_.reset(rocksdb::NewGenericRateLimiter(static_cast<int64_t>(rate_limit_mb) * 1024 * 1024));
+  }
+}
+
+DbStorage::PruningStats DbStorage::getPruningStats() const {
+  PruningStats stats;
+  {
+    std::unique_lock lock(pruning_mutex_);
+    stats.period_target = pruning_target_.period;
+    stats.dag_level_target = pruning_target_.dag_level;
+  }
+  stats.period_cursor = pruning_period_cursor_;
+  stats.dag_level_cursor = pruning_dag_level_cursor_;
+  stats.removed_keys = pruning_removed_keys_;
+  return stats;
+}
+
+void DbStorage::pruneHistory() {
+  if (!pruning_period_cursor_) {
+    pruning_period_cursor_ = getStatusField(StatusDbField::PrunedPeriod);
+  }
+  if (!pruning_dag_level_cursor_) {
+    pruning_dag_level_cursor_ = getStatusField(StatusDbField::PrunedDagLevel);
+  }
+
+  auto retry_delay = kPruningRetryDelay;
+  while (!pruning_stopped_) {
+    PruningTarget target;
+    {
+      std::unique_lock lock(pruning_mutex_);
+      if (pruning_target_ == pruning_done_target_) {
+        pruning_scheduled_ = false;
+        return;
+      }
+      target = pruning_target_;
+    }
+
+    try {
+      prunePeriodData(target.period);
+      pruneDagLevels(target.dag_level);
+    } catch (const std::exception& e) {
+      // Cursors are persisted per chunk, so retry continues from the last pruned chunk
+      LOG(log_er_) << "History pruning failed, retrying in " << retry_delay.count() << "s: " << e.what();
+      std::unique_lock lock(pruning_mutex_);
+      pruning_cv_.wait_for(lock, retry_delay, [this] { return pruning_stopped_.load(); });
+      retry_delay = std::min(retry_delay * 2, kMaxPruningRetryDelay);
+      continue;
+    }
+    retry_delay = kPruningRetryDelay;
+
+    std::unique_lock lock(pruning_mutex_);
+    pruning_done_target_ = target;
+  }
+}
+
+void DbStorage::commitPruningBatch(Batch& write_batch) {
+  pruning_removed_keys_ += write_batch.Count();
+  if (pruning_rate_limiter_) {
+    const auto burst = static_cast<size_t>(pruning_rate_limiter_->GetSingleBurstBytes());
+    for (auto remaining = write_batch.GetDataSize(); remaining;) {
+      const auto bytes = std::min(remaining, burst);
+      pruning_rate_limiter_->Request(bytes, rocksdb::Env::IO_LOW, nullptr, rocksdb::RateLimiter::OpType::kWrite);
+      remaining -= bytes;
+    }
+  }
+  commitWriteBatch(write_batch);
+}
+
+void DbStorage::prunePeriodData(PbftPeriod end_period) {
+  auto start_period = pruning_period_cursor_.load();
+  if (!start_period) {
+    // Pruning was never run with cursor, find the first non-deleted period
+    auto it = std::unique_ptr<rocksdb::Iterator>(db_->NewIterator(read_options_, handle(Columns::period_data)));
+    it->SeekToFirst();
+    if (!it->Valid()) {
+      return;
+    }
+    memcpy(&start_period, it->key().data(), sizeof(uint64_t));
+  }
+  if (start_period >= end_period) {
     return;
   }
 
-  uint64_t start_level;
-  memcpy(&start_level, it->key().data(), sizeof(uint64_t));
-  if (start_period < end_period) {
+  LOG(log_si_) << "Pruning period data history from " << start_period << " to " << end_period;
+  auto chunk_start = start_period;
+  while (chunk_start < end_period && !pruning_stopped_) {
+    const PbftPeriod chunk_end = std::min(chunk_start + kPruningChunkSize, end_period);
     auto write_batch = createWriteBatch();
-    // Delete up to max 10000 period at once
-    const uint32_t max_batch_delete = 10000;
-    auto start_slice = toSlice(start_period);
-    auto end_slice = toSlice(end_period);
-
-    for (auto period = start_period; period < end_period; period++) {
+    for (auto period = chunk_start; period < chunk_end; period++) {
       // Find transactions included in the old blocks and delete data related to these transactions to free
       // disk space
       const auto& [pbft_block_hash, dag_blocks] = getLastPbftBlockHashAndFinalizedDagBlockByPeriod(period);
@@ -633,50 +1164,91 @@ void DbStorage::clearPeriodDataHistory(PbftPeriod end_period, uint64_t dag_level
         auto chunk_id = h256(index / final_chain::c_bloomIndexSize * 0xff + level);
         remove(write_batch, Columns::final_chain_log_blooms_index, chunk_id);
       }
+    }
 
-      if ((period - start_period + 1) % max_batch_delete == 0) {
-        commitWriteBatch(write_batch);
-        write_batch = createWriteBatch();
+    // Log index keys of pruned blocks are listed by block keys, which are ordered by block number
+    const auto log_index_start = final_chain::logIndexKey(final_chain::kLogIndexBlock, {}, chunk_start);
+    const auto log_index_end = final_chain::logIndexKey(final_chain::kLogIndexBlock, {}, chunk_end);
+    auto log_index_it =
+        std::unique_ptr<rocksdb::Iterator>(db_->NewIterator(read_options_, handle(Columns::final_chain_log_index)));
+    for (log_index_it->Seek(toSlice(log_index_start));
+         log_index_it->Valid() && log_index_it->key().compare(toSlice(log_index_end)) < 0; log_index_it->Next()) {
+      for (const auto& key : dev::RLP(log_index_it->value().ToString())) {
+        remove(write_batch, Columns::final_chain_log_index, key.toBytes());
       }
     }
-
-    commitWriteBatch(write_batch);
-    db_->DeleteRange(write_options_, handle(Columns::period_data), start_slice, end_slice);
-    db_->DeleteRange(write_options_, handle(Columns::pillar_block), start_slice, end_slice);
-
-    // Deletion alone does not guarantee that the disk space is freed, CompactRange actually compacts
-    // the data in the database and free disk space
-    db_->CompactRange({}, handle(Columns::period_data), &start_slice, &end_slice);
-    db_->CompactRange({}, handle(Columns::pillar_block), &start_slice, &end_slice);
-    db_->CompactRange({}, handle(Columns::final_chain_receipt_by_trx_hash), nullptr, nullptr);
-    db_->CompactRange({}, handle(Columns::pbft_block_period), nullptr, nullptr);
-    db_->CompactRange({}, handle(Columns::final_chain_log_blooms_index), nullptr, nullptr);
+    checkStatus(write_batch.DeleteRange(handle(Columns::final_chain_log_index), toSlice(log_index_start),
+                                        toSlice(log_index_end)));
+
+    // Columns keyed by period are deleted with a single range tombstone per chunk
+    const auto start_slice = toSlice(chunk_start);
+    const auto end_slice = toSlice(chunk_end);
+    checkStatus(write_batch.DeleteRange(handle(Columns::period_data), start_slice, end_slice));
+    checkStatus(write_batch.DeleteRange(handle(Columns::period_data_head), start_slice, end_slice));
+    checkStatus(write_batch.DeleteRange(handle(Columns::pillar_block), start_slice, end_slice));
+    checkStatus(write_batch.DeleteRange(handle(Columns::final_chain_receipts_by_block), start_slice, end_slice));
+    addStatusFieldToBatch(StatusDbField::PrunedPeriod, chunk_end, write_batch);
+    commitPruningBatch(write_batch);
+
+    pruning_period_cursor_ = chunk_end;
+    chunk_start = chunk_end;
+  }
+
+  // Deletion alone does not free the disk space, compact only the range that was deleted. Columns pruned with point
+  // deletes are compacted by rocksdb itself as their sst files with many tombstones are marked for compaction
+  const auto start_slice = toSlice(start_period);
+  const auto end_slice = toSlice(chunk_start);
+  db_->CompactRange({}, handle(Columns::period_data), &start_slice, &end_slice);
+  db_->CompactRange({}, handle(Columns::period_data_head), &start_slice, &end_slice);
+  db_->CompactRange({}, handle(Columns::pillar_block), &start_slice, &end_slice);
+  db_->CompactRange({}, handle(Columns::final_chain_receipts_by_block), &start_slice, &end_slice);
+  LOG(log_si_) << "Pruning period data history completed up to " << chunk_start;
+}
+
+void DbStorage::pruneDagLevels(uint64_t dag_level_to_keep) {
+  auto start_level = pruning_dag_level_cursor_.load();
+  if (!start_level) {
+    auto it = std::unique_ptr<rocksdb::Iterator>(db_->NewIterator(read_options_, handle(Columns::dag_blocks_level)));
+    it->SeekToFirst();
+    if (!it->Valid()) {
+      return;
+    }
+    memcpy(&start_level, it->key().data(), sizeof(uint64_t));
+  }
+  if (start_level >= dag_level_to_keep) {
+    return;
   }
 
-  if (start_level < dag_level_to_keep) {
+  LOG(log_si_) << "Pruning dag levels from " << start_level << " to " << dag_level_to_keep;
+  auto chunk_start = start_level;
+  while (chunk_start < dag_level_to_keep && !pruning_stopped_) {
+    const uint64_t chunk_end = std::min(chunk_start + kPruningChunkSize, dag_level_to_keep);
     auto write_batch = createWriteBatch();
-    // Delete up to max 10000 period at once
-    const uint32_t max_batch_delete = 10000;
-    auto start_slice = toSlice(start_level);
-    auto end_slice = toSlice(dag_level_to_keep - 1);
-    for (auto level = start_level; level < dag_level_to_keep; level++) {
+    for (auto level = chunk_start; level < chunk_end; level++) {
       // Find old dag blocks and delete data related to these blocks to free disk space
-      auto dag_block_hashes = getBlocksByLevel(level);
-      for (auto dag_block_hash : dag_block_hashes) {
+      for (const auto& dag_block_hash : getBlocksByLevel(level)) {
         remove(write_batch, Columns::dag_block_period, toSlice(dag_block_hash.asBytes()));
       }
-      if ((level - start_level + 1) % max_batch_delete == 0) {
-        commitWriteBatch(write_batch);
-        write_batch = createWriteBatch();
-      }
     }
-    commitWriteBatch(write_batch);
-    db_->DeleteRange(write_options_, handle(Columns::dag_blocks_level), start_slice, end_slice);
 
-    db_->CompactRange({}, handle(Columns::dag_block_period), nullptr, nullptr);
-    db_->CompactRange({}, handle(Columns::dag_blocks_level), nullptr, nullptr);
-    LOG(log_si_) << "Clear light node history completed";
+    // Last level below dag_level_to_keep stays in dag_blocks_level, it is deleted by the next pruning
+    const uint64_t range_start = chunk_start ? chunk_start - 1 : 0;
+    const uint64_t range_end = std::min(chunk_end, dag_level_to_keep - 1);
+    if (range_start < range_end) {
+      checkStatus(
+          write_batch.DeleteRange(handle(Columns::dag_blocks_level), toSlice(range_start), toSlice(range_end)));
+    }
+    addStatusFieldToBatch(StatusDbField::PrunedDagLevel, chunk_end, write_batch);
+    commitPruningBatch(write_batch);
+
+    pruning_dag_level_cursor_ = chunk_end;
+    chunk_start = chunk_end;
   }
+
+  const auto start_slice = toSlice(start_level);
+  const auto end_slice = toSlice(chunk_start);
+  db_->CompactRange({}, handle(Columns::dag_blocks_level), &start_slice, &end_slice);
+  LOG(log_si_) << "Pruning dag levels completed up to " << chunk_start;
 }
 
 void DbStorage::savePeriodData(const PeriodData& period_data, Batch& write_batch) {
@@ -699,20 +1271,38 @@ void DbStorage::savePeriodData(const PeriodData& period_data, Batch& write_batch
     trx_pos++;
   }
 
-  insert(write_batch, Columns::period_data, toSlice(period), toSlice(period_data.rlp()));
+  const auto period_data_rlp = period_data.rlp();
+  addPeriodDataHeadToBatch(period, dev::RLP(period_data_rlp), write_batch);
+  insert(write_batch, Columns::period_data, toSlice(period), toSlice(period_data_rlp));
+}
+
+void DbStorage::addPeriodDataHeadToBatch(PbftPeriod period, const dev::RLP& period_data_rlp, Batch& write_batch) {
+  // Pbft block, cert votes and pillar votes are kept on their positions, dag blocks and transactions are replaced by
+  // empty lists, so the head is decoded the same way as full period data
+  dev::RLPStream s(period_data_rlp.itemCount());
+  size_t pos = 0;
+  for (const auto item : period_data_rlp) {
+    if (pos == DAG_BLOCKS_POS_IN_PERIOD_DATA || pos == TRANSACTIONS_POS_IN_PERIOD_DATA) {
+      s.appendList(0);
+    } else {
+      s.appendRaw(item.data());
+    }
+    ++pos;
+  }
+  insert(write_batch, Columns::period_data_head, toSlice(period), toSlice(s.out()));
 }
 
 dev::bytes DbStorage::getPeriodDataRaw(PbftPeriod period) const {
-  return asBytes(lookup(toSlice(period), Columns::period_data));
+  return lookupPinned(period, Columns::period_data).toBytes();
 }
 
 std::optional<PeriodData> DbStorage::getPeriodData(PbftPeriod period) const {
-  auto period_data_bytes = getPeriodDataRaw(period);
-  if (period_data_bytes.empty()) {
+  const auto period_data = lookupPinned(period, Columns::period_data);
+  if (period_data.empty()) {
     return {};
   }
 
-  return PeriodData{std::move(period_data_bytes)};
+  return PeriodData{period_data.rlp()};
 }
 
 void DbStorage::savePillarBlock(const std::shared_ptr<pillar_chain::PillarBlock>& pillar_block) {
@@ -776,28 +1366,40 @@ void DbStorage::addTransactionLocationToBatch(Batch& write_batch, trx_hash_t con
   insert(write_batch, Columns::trx_period, toSlice(trx_hash.asBytes()), toSlice(s.invalidate()));
 }
 
+static std::optional<final_chain::TransactionLocation> decodeTransactionLocation(const DbStorage::PinnedValue& data) {
+  if (data.empty()) {
+    return std::nullopt;
+  }
+  final_chain::TransactionLocation res;
+  const auto rlp = data.rlp();
+  auto it = rlp.begin();
+  res.period = (*it++).toInt<PbftPeriod>();
+  res.position = (*it++).toInt<uint32_t>();
+  if (rlp.itemCount() == 3) {
+    res.is_system = (*it++).toInt<bool>();
+  }
+  return res;
+}
+
 std::optional<final_chain::TransactionLocation> DbStorage::getTransactionLocation(trx_hash_t const& hash) const {
-  auto data = lookup(toSlice(hash.asBytes()), Columns::trx_period);
-  if (!data.empty()) {
-    final_chain::TransactionLocation res;
-    dev::RLP const rlp(data);
-    auto it = rlp.begin();
-    res.period = (*it++).toInt<PbftPeriod>();
-    res.position = (*it++).toInt<uint32_t>();
-    if (rlp.itemCount() == 3) {
-      res.is_system = (*it++).toInt<bool>();
-    }
-    return res;
+  return decodeTransactionLocation(lookupPinned(hash, Columns::trx_period));
+}
+
+std::vector<std::optional<final_chain::TransactionLocation>> DbStorage::getTransactionLocations(
+    std::vector<trx_hash_t> const& trx_hashes) const {
+  std::vector<std::optional<final_chain::TransactionLocation>> result;
+  result.reserve(trx_hashes.size());
+  for (const auto& data : multiLookup(trx_hashes, Columns::trx_period)) {
+    result.emplace_back(decodeTransactionLocation(data));
   }
-  return std::nullopt;
+  return result;
 }
 
 std::vector<bool> DbStorage::transactionsFinalized(std::vector<trx_hash_t> const& trx_hashes) {
   std::vector<bool> result(trx_hashes.size(), false);
+  const auto locations_data = multiLookup(trx_hashes, Columns::trx_period);
   for (size_t i = 0; i < trx_hashes.size(); ++i) {
-    if (exist(toSlice(trx_hashes[i].asBytes()), Columns::trx_period)) {
-      result[i] = true;
-    }
+    result[i] = !locations_data[i].empty();
   }
   return result;
 }
@@ -827,17 +1429,16 @@ std::vector<std::shared_ptr<PbftBlock>> DbStorage::getProposedPbftBlocks() {
   std::vector<std::shared_ptr<PbftBlock>> res;
   auto i = std::unique_ptr<rocksdb::Iterator>(db_->NewIterator(read_options_, handle(Columns::proposed_pbft_blocks)));
   for (i->SeekToFirst(); i->Valid(); i->Next()) {
-    res.push_back(std::make_shared<PbftBlock>(asBytes(i->value().ToString())));
+    res.push_back(decode(i->value(), TypedColumns::proposed_pbft_blocks));
   }
   return res;
 }
 
 std::optional<PbftBlock> DbStorage::getPbftBlock(PbftPeriod period) const {
-  auto period_data = getPeriodDataRaw(period);
+  const auto period_data = lookupPinned(period, Columns::period_data_head);
   // DB is corrupted if status point to missing or incorrect transaction
-  if (period_data.size() > 0) {
-    auto period_data_rlp = dev::RLP(period_data);
-    return std::optional<PbftBlock>(period_data_rlp[PBFT_BLOCK_POS_IN_PERIOD_DATA]);
+  if (!period_data.empty()) {
+    return std::optional<PbftBlock>(period_data.rlp()[PBFT_BLOCK_POS_IN_PERIOD_DATA]);
   }
   return {};
 }
@@ -851,16 +1452,14 @@ blk_hash_t DbStorage::getPeriodBlockHash(PbftPeriod period) const {
 }
 
 std::shared_ptr<Transaction> DbStorage::getTransaction(trx_hash_t const& hash) {
-  auto data = asBytes(lookup(toSlice(hash.asBytes()), Columns::transactions));
-  if (data.size() > 0) {
-    return std::make_shared<Transaction>(data);
+  if (auto trx = lookup(hash, TypedColumns::transactions)) {
+    return trx;
   }
   auto location = getTransactionLocation(hash);
   if (location && !location->is_system) {
-    auto period_data = getPeriodDataRaw(location->period);
-    if (period_data.size() > 0) {
-      auto period_data_rlp = dev::RLP(period_data);
-      auto transaction_data = period_data_rlp[TRANSACTIONS_POS_IN_PERIOD_DATA];
+    const auto period_data = lookupPinned(location->period, Columns::period_data);
+    if (!period_data.empty()) {
+      auto transaction_data = period_data.rlp()[TRANSACTIONS_POS_IN_PERIOD_DATA];
       return std::make_shared<Transaction>(transaction_data[location->position]);
     }
   } else {
@@ -870,11 +1469,58 @@ std::shared_ptr<Transaction> DbStorage::getTransaction(trx_hash_t const& hash) {
   return nullptr;
 }
 
+SharedTransactions DbStorage::getTransactions(std::vector<trx_hash_t> const& trx_hashes) {
+  SharedTransactions trxs(trx_hashes.size());
+  const auto trxs_data = multiLookup(trx_hashes, Columns::transactions);
+
+  std::vector<size_t> finalized_idx;
+  std::vector<trx_hash_t> finalized_hashes;
+  for (size_t i = 0; i < trx_hashes.size(); ++i) {
+    if (!trxs_data[i].empty()) {
+      trxs[i] = std::make_shared<Transaction>(trxs_data[i].rlp());
+    } else {
+      finalized_idx.push_back(i);
+      finalized_hashes.push_back(trx_hashes[i]);
+    }
+  }
+  if (finalized_hashes.empty()) {
+    return trxs;
+  }
+
+  const auto locations = getTransactionLocations(finalized_hashes);
+  // Map of period to (index in result, position of transaction within a period)
+  std::map<PbftPeriod, std::vector<std::pair<size_t, uint32_t>>> period_map;
+  for (size_t i = 0; i < finalized_hashes.size(); ++i) {
+    if (locations[i] && !locations[i]->is_system) {
+      period_map[locations[i]->period].emplace_back(finalized_idx[i], locations[i]->position);
+    } else {
+      // get system trx from a different column
+      trxs[finalized_idx[i]] = getSystemTransaction(finalized_hashes[i]);
+    }
+  }
+
+  std::vector<PbftPeriod> periods;
+  periods.reserve(period_map.size());
+  for (const auto& it : period_map) {
+    periods.push_back(it.first);
+  }
+  const auto periods_data = multiLookup(periods, Columns::period_data);
+  for (size_t i = 0; i < periods.size(); ++i) {
+    if (periods_data[i].empty()) {
+      continue;
+    }
+    const auto transactions_rlp = periods_data[i].rlp()[TRANSACTIONS_POS_IN_PERIOD_DATA];
+    for (const auto& [idx, pos] : period_map[periods[i]]) {
+      trxs[idx] = std::make_shared<Transaction>(transactions_rlp[pos]);
+    }
+  }
+  return trxs;
+}
+
 uint64_t DbStorage::getTransactionCount(PbftPeriod period) const {
-  auto period_data = getPeriodDataRaw(period);
-  if (period_data.size()) {
-    auto period_data_rlp = dev::RLP(period_data);
-    return period_data_rlp[TRANSACTIONS_POS_IN_PERIOD_DATA].itemCount();
+  const auto period_data = lookupPinned(period, Columns::period_data);
+  if (!period_data.empty()) {
+    return period_data.rlp()[TRANSACTIONS_POS_IN_PERIOD_DATA].itemCount();
   }
   return 0;
 }
@@ -884,20 +1530,26 @@ SharedTransactions DbStorage::getFinalizedTransactions(std::vector<trx_hash_t> c
   // Map of period to position of transactions within a period
   std::map<PbftPeriod, std::set<uint32_t>> period_map;
   trxs.reserve(trx_hashes.size());
-  for (auto const& tx_hash : trx_hashes) {
-    auto trx_period = getTransactionLocation(tx_hash);
+  for (auto const& trx_period : getTransactionLocations(trx_hashes)) {
     if (trx_period.has_value()) {
       period_map[trx_period->period].insert(trx_period->position);
     }
   }
-  for (auto it : period_map) {
-    const auto period_data = getPeriodDataRaw(it.first);
-    if (!period_data.size()) {
+
+  std::vector<PbftPeriod> periods;
+  periods.reserve(period_map.size());
+  for (const auto& it : period_map) {
+    periods.push_back(it.first);
+  }
+  const auto periods_data = multiLookup(periods, Columns::period_data);
+  for (size_t i = 0; i < periods.size(); ++i) {
+    if (periods_data[i].empty()) {
       assert(false);
+      continue;
     }
 
-    auto const transactions_rlp = dev::RLP(period_data)[TRANSACTIONS_POS_IN_PERIOD_DATA];
-    for (auto pos : it.second) {
+    auto const transactions_rlp = periods_data[i].rlp()[TRANSACTIONS_POS_IN_PERIOD_DATA];
+    for (auto pos : period_map[periods[i]]) {
       trxs.emplace_back(std::make_shared<Transaction>(transactions_rlp[pos]));
     }
   }
@@ -948,13 +1600,12 @@ SharedTransactions DbStorage::getPeriodSystemTransactions(PbftPeriod period) con
 }
 
 std::vector<std::shared_ptr<PbftVote>> DbStorage::getPeriodCertVotes(PbftPeriod period) const {
-  auto period_data = getPeriodDataRaw(period);
+  const auto period_data = lookupPinned(period, Columns::period_data_head);
   if (period_data.empty()) {
     return {};
   }
 
-  auto period_data_rlp = dev::RLP(period_data);
-  auto votes_rlp = period_data_rlp[CERT_VOTES_POS_IN_PERIOD_DATA];
+  auto votes_rlp = period_data.rlp()[CERT_VOTES_POS_IN_PERIOD_DATA];
   if (votes_rlp.itemCount() == 0) {
     return {};
   }
@@ -962,12 +1613,12 @@ std::vector<std::shared_ptr<PbftVote>> DbStorage::getPeriodCertVotes(PbftPeriod
 }
 
 std::optional<SharedTransactions> DbStorage::getPeriodTransactions(PbftPeriod period) const {
-  const auto period_data = getPeriodDataRaw(period);
-  if (!period_data.size()) {
+  const auto period_data = lookupPinned(period, Columns::period_data);
+  if (period_data.empty()) {
     return std::nullopt;
   }
 
-  auto period_data_rlp = dev::RLP(period_data);
+  auto period_data_rlp = period_data.rlp();
 
   SharedTransactions ret(period_data_rlp[TRANSACTIONS_POS_IN_PERIOD_DATA].size());
   for (const auto transaction_data : period_data_rlp[TRANSACTIONS_POS_IN_PERIOD_DATA]) {
@@ -979,12 +1630,12 @@ std::optional<SharedTransactions> DbStorage::getPeriodTransactions(PbftPeriod pe
 }
 
 std::vector<std::shared_ptr<PillarVote>> DbStorage::getPeriodPillarVotes(PbftPeriod period) const {
-  const auto period_data = getPeriodDataRaw(period);
-  if (!period_data.size()) {
+  const auto period_data = lookupPinned(period, Columns::period_data_head);
+  if (period_data.empty()) {
     return {};
   }
 
-  auto period_data_rlp = dev::RLP(period_data);
+  auto period_data_rlp = period_data.rlp();
   // This could potentially happen if getPeriodPillarVotes is called for period that does not contain pillar votes
   if (period_data_rlp.itemCount() < PILLAR_VOTES_POS_IN_PERIOD_DATA) {
     return {};
@@ -1011,12 +1662,23 @@ bool DbStorage::transactionFinalized(trx_hash_t const& hash) {
 
 std::vector<bool> DbStorage::transactionsInDb(std::vector<trx_hash_t> const& trx_hashes) {
   std::vector<bool> result(trx_hashes.size(), false);
+  const auto trxs_data = multiLookup(trx_hashes, Columns::transactions);
+
+  // Transactions not found in non finalized column are looked up in the finalized one
+  std::vector<size_t> missing_idx;
+  std::vector<trx_hash_t> missing_hashes;
   for (size_t i = 0; i < trx_hashes.size(); ++i) {
-    const auto key = trx_hashes[i].asBytes();
-    if (exist(toSlice(key), Columns::transactions) || exist(toSlice(key), Columns::trx_period)) {
+    if (!trxs_data[i].empty()) {
       result[i] = true;
+    } else {
+      missing_idx.push_back(i);
+      missing_hashes.push_back(trx_hashes[i]);
     }
   }
+  const auto finalized = transactionsFinalized(missing_hashes);
+  for (size_t i = 0; i < missing_idx.size(); ++i) {
+    result[missing_idx[i]] = finalized[i];
+  }
   return result;
 }
 
@@ -1088,12 +1750,12 @@ void DbStorage::saveCertVotedBlockInRound(PbftRound round, const std::shared_ptr
 }
 
 std::optional<std::pair<PbftRound, std::shared_ptr<PbftBlock>>> DbStorage::getCertVotedBlockInRound() const {
-  auto value = asBytes(lookup(0, Columns::cert_voted_block_in_round));
+  const auto value = lookupPinned(0, Columns::cert_voted_block_in_round);
   if (value.empty()) {
     return {};
   }
 
-  auto value_rlp = dev::RLP(value);
+  auto value_rlp = value.rlp();
   assert(value_rlp.itemCount() == 2);
 
   std::pair<PbftRound, std::shared_ptr<PbftBlock>> ret;
@@ -1139,7 +1801,7 @@ std::vector<std::shared_ptr<PbftVote>> DbStorage::getOwnVerifiedVotes() {
   auto it =
       std::unique_ptr<rocksdb::Iterator>(db_->NewIterator(read_options_, handle(Columns::latest_round_own_votes)));
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    votes.emplace_back(std::make_shared<PbftVote>(asBytes(it->value().ToString())));
+    votes.emplace_back(decode(it->value(), TypedColumns::latest_round_own_votes));
   }
 
   return votes;
@@ -1178,8 +1840,8 @@ void DbStorage::replaceTwoTPlusOneVotesToBatch(TwoTPlusOneVotedBlockType type,
 std::vector<std::shared_ptr<PbftVote>> DbStorage::getAllTwoTPlusOneVotes() {
   std::vector<std::shared_ptr<PbftVote>> votes;
   auto load_db_votes = [this, &votes](TwoTPlusOneVotedBlockType type) {
-    auto votes_raw = asBytes(lookup(static_cast<uint8_t>(type), Columns::latest_round_two_t_plus_one_votes));
-    auto votes_rlp = dev::RLP(votes_raw);
+    const auto votes_raw = lookupPinned(static_cast<uint8_t>(type), Columns::latest_round_two_t_plus_one_votes);
+    auto votes_rlp = votes_raw.rlp();
     votes.reserve(votes.size() + votes_rlp.size());
 
     for (const auto vote : votes_rlp) {
@@ -1210,7 +1872,7 @@ std::vector<std::shared_ptr<PbftVote>> DbStorage::getRewardVotes() {
 
   auto it = std::unique_ptr<rocksdb::Iterator>(db_->NewIterator(read_options_, handle(Columns::extra_reward_votes)));
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    votes.emplace_back(std::make_shared<PbftVote>(asBytes(it->value().ToString())));
+    votes.emplace_back(decode(it->value(), TypedColumns::extra_reward_votes));
   }
 
   return votes;
@@ -1257,8 +1919,8 @@ void DbStorage::addDagBlockPeriodToBatch(blk_hash_t const& hash, PbftPeriod peri
 
 std::vector<blk_hash_t> DbStorage::getFinalizedDagBlockHashesByPeriod(PbftPeriod period) {
   std::vector<blk_hash_t> ret;
-  if (auto period_data = getPeriodDataRaw(period); period_data.size() > 0) {
-    auto dag_blocks_data = dev::RLP(period_data)[DAG_BLOCKS_POS_IN_PERIOD_DATA];
+  if (const auto period_data = lookupPinned(period, Columns::period_data); !period_data.empty()) {
+    auto dag_blocks_data = period_data.rlp()[DAG_BLOCKS_POS_IN_PERIOD_DATA];
     const auto dag_blocks = decodeDAGBlocksBundleRlp(dag_blocks_data);
     ret.reserve(dag_blocks.size());
     std::transform(dag_blocks.begin(), dag_blocks.end(), std::back_inserter(ret),
@@ -1269,23 +1931,30 @@ std::vector<blk_hash_t> DbStorage::getFinalizedDagBlockHashesByPeriod(PbftPeriod
 }
 
 std::vector<std::shared_ptr<DagBlock>> DbStorage::getFinalizedDagBlockByPeriod(PbftPeriod period) {
-  auto period_data = getPeriodDataRaw(period);
-  if (period_data.empty()) {
-    return {};
-  }
+  return std::move(getFinalizedDagBlockByPeriods({period}).front());
+}
 
-  auto dag_blocks_data = dev::RLP(period_data)[DAG_BLOCKS_POS_IN_PERIOD_DATA];
-  return decodeDAGBlocksBundleRlp(dag_blocks_data);
+std::vector<std::vector<std::shared_ptr<DagBlock>>> DbStorage::getFinalizedDagBlockByPeriods(
+    std::vector<PbftPeriod> const& periods) {
+  std::vector<std::vector<std::shared_ptr<DagBlock>>> blocks(periods.size());
+  const auto periods_data = multiLookup(periods, Columns::period_data);
+  for (size_t i = 0; i < periods.size(); ++i) {
+    if (periods_data[i].empty()) {
+      continue;
+    }
+    blocks[i] = decodeDAGBlocksBundleRlp(periods_data[i].rlp()[DAG_BLOCKS_POS_IN_PERIOD_DATA]);
+  }
+  return blocks;
 }
 
 std::pair<blk_hash_t, std::vector<std::shared_ptr<DagBlock>>>
 DbStorage::getLastPbftBlockHashAndFinalizedDagBlockByPeriod(PbftPeriod period) {
-  auto period_data = getPeriodDataRaw(period);
+  const auto period_data = lookupPinned(period, Columns::period_data);
   if (period_data.empty()) {
     return {};
   }
 
-  const auto period_data_rlp = dev::RLP(period_data);
+  const auto period_data_rlp = period_data.rlp();
   auto dag_blocks_data = period_data_rlp[DAG_BLOCKS_POS_IN_PERIOD_DATA];
   auto blocks = decodeDAGBlocksBundleRlp(dag_blocks_data);
   auto last_pbft_block_hash =
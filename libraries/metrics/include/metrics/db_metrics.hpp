@@ -0,0 +1,66 @@
+#pragma once
+
+#include "metrics/metrics_group.hpp"
+
+namespace taraxa::metrics {
+
+/**
+ * @brief add method that is setting specific gauge metric labeled by db column name.
+ */
+#define ADD_COLUMN_GAUGE_METRIC(method, name, description)                                    \
+  void method(const std::string& column, double v) {                                         \
+    static auto& family = addMetric<prometheus::Gauge>(group_name + "_" + name, description); \
+    family.Add({{"column", column}}).Set(v);                                                 \
+  }
+
+/**
+ * @brief add method that is setting specific counter metric labeled by db column name to cumulative value
+ */
+#define ADD_COLUMN_COUNTER_METRIC(method, name, description)                                    \
+  void method(const std::string& column, double v) {                                            \
+    static auto& family = addMetric<prometheus::Counter>(group_name + "_" + name, description); \
+    auto& counter = family.Add({{"column", column}});                                           \
+    counter.Increment(v - counter.Value());                                                     \
+  }
+
+class DbMetrics : public MetricsGroup {
+ public:
+  inline static const std::string group_name = "db";
+  DbMetrics(std::shared_ptr<prometheus::Registry> registry) : MetricsGroup(std::move(registry)) {}
+
+  ADD_COLUMN_GAUGE_METRIC(setColumnBloomBitsPerKey, "column_bloom_bits_per_key", "Bloom filter bits per key of column")
+  ADD_COLUMN_GAUGE_METRIC(setColumnBlockSize, "column_block_size", "Data block size of column")
+  ADD_COLUMN_GAUGE_METRIC(setColumnBlockCacheCapacity, "column_block_cache_capacity",
+                          "Capacity of block cache used by column")
+  ADD_COLUMN_GAUGE_METRIC(setColumnBlockCacheUsage, "column_block_cache_usage", "Usage of block cache used by column")
+  ADD_COLUMN_COUNTER_METRIC(setColumnBlockCacheHit, "column_block_cache_hit",
+                            "Block cache hits of column point lookups")
+  ADD_COLUMN_COUNTER_METRIC(setColumnBlockCacheMiss, "column_block_cache_miss",
+                            "Block cache misses of column point lookups")
+  ADD_COLUMN_GAUGE_METRIC(setColumnEstimateNumKeys, "column_estimate_num_keys", "Estimated number of keys in column")
+  ADD_COLUMN_GAUGE_METRIC(setColumnLiveSstFilesSize, "column_live_sst_files_size",
+                          "Total size of live sst files of column")
+
+  ADD_GAUGE_METRIC(setBlockCacheCapacity, "block_cache_capacity", "Capacity of shared block cache")
+  ADD_GAUGE_METRIC(setBlockCacheUsage, "block_cache_usage", "Usage of shared block cache")
+  ADD_GAUGE_METRIC(setBlockCachePinnedUsage, "block_cache_pinned_usage", "Pinned usage of shared block cache")
+  ADD_COUNTER_METRIC(setBlockCacheHit, "block_cache_hit", "Block cache hits of all columns")
+  ADD_COUNTER_METRIC(setBlockCacheMiss, "block_cache_miss", "Block cache misses of all columns")
+  ADD_GAUGE_METRIC(setRowCacheCapacity, "row_cache_capacity", "Capacity of row cache")
+  ADD_GAUGE_METRIC(setRowCacheUsage, "row_cache_usage", "Usage of row cache")
+  ADD_COUNTER_METRIC(setRowCacheHit, "row_cache_hit", "Row cache hits")
+  ADD_COUNTER_METRIC(setRowCacheMiss, "row_cache_miss", "Row cache misses")
+  ADD_GAUGE_METRIC(setPruningPeriodCursor, "pruning_period_cursor", "Periods below this one are pruned")
+  ADD_GAUGE_METRIC(setPruningPeriodTarget, "pruning_period_target", "Period up to which history is being pruned")
+  ADD_GAUGE_METRIC(setPruningDagLevelCursor, "pruning_dag_level_cursor", "Dag levels below this one are pruned")
+  ADD_GAUGE_METRIC(setPruningDagLevelTarget, "pruning_dag_level_target",
+                   "Dag level up to which history is being pruned")
+  ADD_COUNTER_METRIC(setPruningRemovedKeys, "pruning_removed_keys", "Keys removed by history pruning since node start")
+
+  /**
+   * @brief registers updater that sets all db stats at once
+   */
+  void setStatsUpdater(MetricUpdater updater) { updaters_.push_back(std::move(updater)); }
+};
+
+}  // namespace taraxa::metrics
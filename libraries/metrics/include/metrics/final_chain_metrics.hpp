@@ -0,0 +1,31 @@
+#pragma once
+
+#include "metrics/metrics_group.hpp"
+
+namespace taraxa::metrics {
+
+/**
+ * @brief add method that is setting specific gauge metric labeled by cache name.
+ */
+#define ADD_CACHE_GAUGE_METRIC(method, name, description)                                     \
+  void method(const std::string& cache, double v) {                                           \
+    static auto& family = addMetric<prometheus::Gauge>(group_name + "_" + name, description); \
+    family.Add({{"cache", cache}}).Set(v);                                                    \
+  }
+
+class FinalChainMetrics : public MetricsGroup {
+ public:
+  inline static const std::string group_name = "final_chain";
+  FinalChainMetrics(std::shared_ptr<prometheus::Registry> registry) : MetricsGroup(std::move(registry)) {}
+
+  ADD_CACHE_GAUGE_METRIC(setCacheHits, "cache_hits", "Hits of final chain cache")
+  ADD_CACHE_GAUGE_METRIC(setCacheMisses, "cache_misses", "Misses of final chain cache, each one is a db/state read")
+  ADD_CACHE_GAUGE_METRIC(setCacheEvictions, "cache_evictions", "Values evicted from final chain cache")
+
+  /**
+   * @brief registers updater that sets stats of all caches at once
+   */
+  void setCachesStatsUpdater(MetricUpdater updater) { updaters_.push_back(std::move(updater)); }
+};
+
+}  // namespace taraxa::metrics
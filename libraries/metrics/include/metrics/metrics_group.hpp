@@ -1,5 +1,6 @@
 #pragma once
 
+#include <prometheus/counter.h>
 #include <prometheus/gauge.h>
 #include <prometheus/registry.h>
 
@@ -16,6 +17,16 @@ namespace taraxa::metrics {
     label.Set(v);                                                                                    \
   }
 
+/**
+ * @brief add method that is setting specific counter metric to cumulative value, counter only grows so lower values
+ * are ignored
+ */
+#define ADD_COUNTER_METRIC(method, name, description)                                                  \
+  void method(double v) {                                                                              \
+    static auto& label = addMetric<prometheus::Counter>(group_name + "_" + name, description).Add({}); \
+    label.Increment(v - label.Value());                                                                \
+  }
+
 /**
  * @brief add updater method.
  * This is used to store lambda function that updates metric, so we can update it periodically
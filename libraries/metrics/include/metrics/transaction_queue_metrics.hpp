@@ -9,5 +9,14 @@ class TransactionQueueMetrics : public MetricsGroup {
   TransactionQueueMetrics(std::shared_ptr<prometheus::Registry> registry) : MetricsGroup(std::move(registry)) {}
   ADD_GAUGE_METRIC_WITH_UPDATER(setTransactionsCount, "transactions_count", "Transactions count in transactions queue")
   ADD_GAUGE_METRIC_WITH_UPDATER(setGasPrice, "gas_price", "Current gas price")
+  ADD_GAUGE_METRIC(setGasEstimationCacheHits, "gas_estimation_cache_hits", "Hits of transactions gas estimation cache")
+  ADD_GAUGE_METRIC(setGasEstimationCacheMisses, "gas_estimation_cache_misses",
+                   "Misses of transactions gas estimation cache, each one is an evm dry run")
+  ADD_GAUGE_METRIC(setGasEstimationTime, "gas_estimation_time_us", "Total time spent in evm dry runs of gas estimation")
+
+  /**
+   * @brief registers updater that sets all gas estimation stats at once
+   */
+  void setGasEstimationStatsUpdater(MetricUpdater updater) { updaters_.push_back(std::move(updater)); }
 };
 }  // namespace taraxa::metrics
\ No newline at end of file
@@ -104,6 +104,12 @@ class DagBlock {
   bool verifySig() const;
   void verifyVdf(const SortitionParams &vdf_config, const h256 &proposal_period_hash, const vrf_wrapper::vrf_pk_t &pk,
                  uint64_t vote_count, uint64_t total_vote_count) const;
+  /**
+   * @brief Returns arguments of verifyVdf to verify block sortition in batch with VdfSortition::verifyVdfs
+   */
+  vdf_sortition::VdfVerification getVdfVerification(const SortitionParams &vdf_config, const h256 &proposal_period_hash,
+                                                    const vrf_wrapper::vrf_pk_t &pk, uint64_t vote_count,
+                                                    uint64_t total_vote_count) const;
   bytes rlp(bool include_sig, bool include_trxs = true) const;
 
   /**
@@ -125,15 +125,27 @@ bool DagBlock::verifySig() const {
 
 void DagBlock::verifyVdf(const SortitionParams &vdf_config, const h256 &proposal_period_hash,
                          const vrf_wrapper::vrf_pk_t &pk, uint64_t vote_count, uint64_t total_vote_count) const {
+  const auto v = getVdfVerification(vdf_config, proposal_period_hash, pk, vote_count, total_vote_count);
+  vdf_.verifyVdf(v.config, v.vrf_input, v.pk, v.vdf_input, v.vote_count, v.total_vote_count);
+}
+
+vdf_sortition::VdfVerification DagBlock::getVdfVerification(const SortitionParams &vdf_config,
+                                                            const h256 &proposal_period_hash,
+                                                            const vrf_wrapper::vrf_pk_t &pk, uint64_t vote_count,
+                                                            uint64_t total_vote_count) const {
   dev::RLPStream s;
   s << getPivot();
   for (const auto &trx : getTrxs()) {
     s << trx;
   }
-  dev::bytes vdf_msg = s.invalidate();
 
-  vdf_.verifyVdf(vdf_config, VrfSortitionBase::makeVrfInput(getLevel(), proposal_period_hash), pk, vdf_msg, vote_count,
-                 total_vote_count);
+  return {.vdf = vdf_,
+          .config = vdf_config,
+          .vrf_input = VrfSortitionBase::makeVrfInput(getLevel(), proposal_period_hash),
+          .pk = pk,
+          .vdf_input = s.invalidate(),
+          .vote_count = vote_count,
+          .total_vote_count = total_vote_count};
 }
 
 blk_hash_t const &DagBlock::getHash() const {
@@ -70,6 +70,8 @@ struct Transaction {
   auto getCost() const { return gas_price_ * gas_ + value_; }
 
   virtual const addr_t &getSender() const;
+  // True if sender was already recovered from signature(or signature was found invalid) and is cached
+  bool isSenderRecovered() const { return sender_initialized_; }
 
   bool operator==(Transaction const &other) const { return getHash() == other.getHash(); }
 
@@ -44,24 +44,30 @@ Transaction::Transaction(const trx_nonce_t &nonce, const val_t &value, const val
   getSender();
 }
 
+[[noreturn]] static void throwTransactionRLPError(const dev::RLPException &e) {
+  // TODO[1881]: this should be removed when we will add typed transactions support
+  std::string error_msg =
+      "Can't parse transaction from RLP. Use legacy transactions because typed transactions aren't supported yet.";
+  error_msg += "\nException details:\n";
+  error_msg += e.what();
+  BOOST_THROW_EXCEPTION(RLPException() << errinfo_comment(error_msg));
+}
+
 Transaction::Transaction(const bytes &_bytes, bool verify_strict, const h256 &hash) {
-  dev::RLP rlp;
   try {
-    rlp = dev::RLP(_bytes);
+    fromRLP(dev::RLP(_bytes), verify_strict, hash);
   } catch (const dev::RLPException &e) {
-    // TODO[1881]: this should be removed when we will add typed transactions support
-    std::string error_msg =
-        "Can't parse transaction from RLP. Use legacy transactions because typed transactions aren't supported yet.";
-    error_msg += "\nException details:\n";
-    error_msg += e.what();
-    BOOST_THROW_EXCEPTION(RLPException() << errinfo_comment(error_msg));
+    throwTransactionRLPError(e);
   }
-
-  fromRLP(rlp, verify_strict, hash);
 }
 
 Transaction::Transaction(const dev::RLP &_rlp, bool verify_strict, const h256 &hash) {
-  fromRLP(_rlp, verify_strict, hash);
+  // RLP is already parsed here, so malformed items are found only while decoding fields
+  try {
+    fromRLP(_rlp, verify_strict, hash);
+  } catch (const dev::RLPException &e) {
+    throwTransactionRLPError(e);
+  }
 }
 
 void Transaction::fromRLP(const dev::RLP &_rlp, bool verify_strict, const h256 &hash) {
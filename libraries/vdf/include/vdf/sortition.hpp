@@ -1,5 +1,9 @@
 #pragma once
 
+#include <boost/asio/thread_pool.hpp>
+#include <optional>
+#include <vector>
+
 #include "common/types.hpp"
 #include "common/vrf_wrapper.hpp"
 #include "libdevcore/CommonData.h"
@@ -9,6 +13,8 @@ namespace taraxa::vdf_sortition {
 
 using namespace vrf_wrapper;
 
+struct VdfVerification;
+
 // It includes a vrf for difficulty adjustment
 class VdfSortition : public vrf_wrapper::VrfSortitionBase {
  public:
@@ -27,6 +33,14 @@ class VdfSortition : public vrf_wrapper::VrfSortitionBase {
   void verifyVdf(SortitionParams const& config, bytes const& vrf_input, const vrf_pk_t& pk, bytes const& vdf_input,
                  uint64_t vote_count, uint64_t total_vote_count) const;
 
+  /**
+   * @brief Verifies batch of sortitions on the pool, each of them same as verifyVdf
+   * @return error of every sortition that failed verification, nullopt for valid sortitions
+   */
+  static std::vector<std::optional<InvalidVdfSortition>> verifyVdfs(const std::vector<VdfVerification>& verifications,
+                                                                    boost::asio::thread_pool* pool,
+                                                                    uint32_t pool_threads);
+
   bytes rlp() const;
   bool operator==(VdfSortition const& other) const {
     return vrf_wrapper::VrfSortitionBase::operator==(other) && vdf_sol_.first == other.vdf_sol_.first &&
@@ -66,4 +80,18 @@ class VdfSortition : public vrf_wrapper::VrfSortitionBase {
   static const uint32_t kThresholdCorrection = 10;
 };
 
+/**
+ * @brief Sortition with all verifyVdf arguments, used for batch verification. Sortition is copied, so verification
+ * doesn't depend on lifetime of its source
+ */
+struct VdfVerification {
+  VdfSortition vdf;
+  SortitionParams config;
+  bytes vrf_input;
+  vrf_pk_t pk;
+  bytes vdf_input;
+  uint64_t vote_count;
+  uint64_t total_vote_count;
+};
+
 }  // namespace taraxa::vdf_sortition
@@ -104,6 +104,23 @@ void VdfSortition::verifyVdf(SortitionParams const& config, bytes const& vrf_inp
   }
 }
 
+std::vector<std::optional<VdfSortition::InvalidVdfSortition>> VdfSortition::verifyVdfs(
+    const std::vector<VdfVerification>& verifications, boost::asio::thread_pool* pool, uint32_t pool_threads) {
+  std::vector<std::optional<InvalidVdfSortition>> errors(verifications.size());
+  // VDF verification of a single sortition takes milliseconds, so every sortition can be a separate task
+  runInChunks(pool, pool_threads, verifications.size(), 1, [&](size_t begin, size_t end) {
+    for (auto i = begin; i < end; ++i) {
+      const auto& v = verifications[i];
+      try {
+        v.vdf.verifyVdf(v.config, v.vrf_input, v.pk, v.vdf_input, v.vote_count, v.total_vote_count);
+      } catch (const InvalidVdfSortition& e) {
+        errors[i] = e;
+      }
+    }
+  });
+  return errors;
+}
+
 bool VdfSortition::verifyVrf(const vrf_pk_t& pk, const bytes& vrf_input, uint16_t vote_count) const {
   return VrfSortitionBase::verify(pk, vrf_input, vote_count);
 }
@@ -1,6 +1,10 @@
 #include "final_chain/cache.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <iostream>
 #include <optional>
+#include <thread>
 
 #include "test_util/gtest.hpp"
 
@@ -12,26 +16,20 @@ struct CacheTest : WithDataDir {};
 class ValueCacheTestable : public ValueByBlockCache<uint64_t> {
  public:
   ValueCacheTestable(uint64_t limit) : ValueByBlockCache<uint64_t>(limit, [](uint64_t a) { return a; }) {}
-  uint64_t blocksSize() { return data_by_block_.size(); }
+  uint64_t blocksSize() { return blocksCount(); }
 
-  bool haveBlock(uint64_t block) { return data_by_block_.contains(block); }
+  bool haveBlock(uint64_t block) { return containsBlock(block); }
 };
 
 class MapCacheTestable : public MapByBlockCache<uint64_t, uint64_t> {
  public:
   MapCacheTestable(uint64_t limit)
       : MapByBlockCache<uint64_t, uint64_t>(limit, [](uint64_t a, uint64_t) { return a; }) {}
-  uint64_t blocksSize() { return data_by_block_.size(); }
+  uint64_t blocksSize() { return blocksCount(); }
 
-  bool haveBlock(uint64_t block) { return data_by_block_.contains(block); }
+  bool haveBlock(uint64_t block) { return containsBlock(block); }
 
-  bool contains(uint64_t block, uint64_t key) {
-    auto block_data = data_by_block_.find(block);
-    if (block_data != data_by_block_.end()) {
-      return block_data->second.contains(key);
-    }
-    return false;
-  }
+  bool contains(uint64_t block, uint64_t key) { return containsValue(block, key); }
 };
 
 TEST_F(CacheTest, value_caching) {
@@ -70,8 +68,11 @@ TEST_F(CacheTest, value_overwrite) {
   EXPECT_TRUE(cache.haveBlock(3));
   EXPECT_EQ(cache.blocksSize(), 3);
 
+  // Window is counted by block numbers, so all older blocks are out of it
   EXPECT_EQ(cache.get(10), 10);
-  EXPECT_EQ(cache.blocksSize(), 3);
+  EXPECT_TRUE(cache.haveBlock(10));
+  EXPECT_FALSE(cache.haveBlock(5));
+  EXPECT_EQ(cache.blocksSize(), 1);
 }
 
 TEST_F(CacheTest, map_caching) {
@@ -118,8 +119,100 @@ TEST_F(CacheTest, map_overwrite) {
   EXPECT_TRUE(cache.haveBlock(3));
   EXPECT_EQ(cache.blocksSize(), 3);
 
+  // Window is counted by block numbers, so all older blocks are out of it
   EXPECT_EQ(cache.get(10, 10), 10);
-  EXPECT_EQ(cache.blocksSize(), 3);
+  EXPECT_TRUE(cache.haveBlock(10));
+  EXPECT_FALSE(cache.haveBlock(5));
+  EXPECT_EQ(cache.blocksSize(), 1);
+}
+
+TEST_F(CacheTest, map_getter_called_once) {
+  std::atomic<uint64_t> getter_calls = 0;
+  MapByBlockCache<uint64_t, uint64_t> cache(3, [&](uint64_t blk, uint64_t key) {
+    ++getter_calls;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    return blk + key;
+  });
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 8; ++i) {
+    threads.emplace_back([&] { EXPECT_EQ(cache.get(1, 2), 3); });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(getter_calls, 1);
+  EXPECT_EQ(cache.stats().misses, 1);
+  // Threads either waited for the first one or came after the value was cached
+  EXPECT_EQ(cache.stats().hits + cache.stats().coalesced, 7);
+
+  cache.get(2, 1);
+  cache.get(3, 1);
+  cache.get(4, 1);
+  // Block 1 is out of the window, so value is got again and isn't cached. Its old value is erased by this read
+  EXPECT_EQ(cache.get(1, 2), 3);
+  EXPECT_EQ(getter_calls, 5);
+  EXPECT_EQ(cache.stats().evictions, 1);
+  EXPECT_EQ(cache.get(1, 2), 3);
+  EXPECT_EQ(getter_calls, 6);
+}
+
+TEST_F(CacheTest, concurrent_get) {
+  const uint64_t kBlocks = 10, kKeys = 1000, kGetsPerThread = 20000;
+  MapByBlockCache<uint64_t, uint64_t> cache(kBlocks, [](uint64_t blk, uint64_t key) { return blk + key + 1; });
+  for (uint64_t blk = 0; blk < kBlocks; ++blk) {
+    for (uint64_t key = 0; key < kKeys; ++key) {
+      cache.get(blk, key);
+    }
+  }
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 8; ++i) {
+    threads.emplace_back([&, i] {
+      for (uint64_t j = 0; j < kGetsPerThread; ++j) {
+        const auto blk = (i + j) % kBlocks, key = (i * kGetsPerThread + j * 7919) % kKeys;
+        EXPECT_EQ(cache.get(blk, key), blk + key + 1);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  // All values were cached before, so concurrent gets are served from cache only
+  EXPECT_EQ(cache.stats().misses, kBlocks * kKeys);
+  EXPECT_EQ(cache.stats().hits, threads.size() * kGetsPerThread);
+  EXPECT_EQ(cache.stats().evictions, 0);
+}
+
+TEST_F(CacheTest, DISABLED_concurrent_get_benchmark) {
+  const uint64_t kBlocks = 10, kKeys = 10000, kGetsPerThread = 200000;
+  MapByBlockCache<uint64_t, uint64_t> cache(kBlocks, [](uint64_t blk, uint64_t key) { return blk + key + 1; });
+  for (uint64_t blk = 0; blk < kBlocks; ++blk) {
+    for (uint64_t key = 0; key < kKeys; ++key) {
+      cache.get(blk, key);
+    }
+  }
+
+  for (size_t threads_count : {1, 2, 4, 8, 16, 32}) {
+    std::vector<std::thread> threads;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < threads_count; ++i) {
+      threads.emplace_back([&, i] {
+        for (uint64_t j = 0; j < kGetsPerThread; ++j) {
+          const auto blk = (i + j) % kBlocks, key = (i * kGetsPerThread + j * 7919) % kKeys;
+          ASSERT_EQ(cache.get(blk, key), blk + key + 1);
+        }
+      });
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+    const auto duration =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    const auto gets_per_second = threads_count * kGetsPerThread * 1000000 / std::max<int64_t>(duration, 1);
+    std::cout << threads_count << " threads: " << gets_per_second << " gets/s" << std::endl;
+  }
+  EXPECT_EQ(cache.stats().misses, kBlocks * kKeys);
 }
 
 }  // namespace taraxa::final_chain
@@ -306,6 +306,37 @@ TEST_F(CryptoTest, vdf_proof_verify) {
                VdfSortition::InvalidVdfSortition);
 }
 
+TEST_F(CryptoTest, vdf_batch_verify) {
+  SortitionParams sortition_params(255, 5, 10, 10, 1500);
+  vrf_sk_t sk(
+      "0b6627a6680e01cea3d9f36fa797f7f34e8869c3a526d9ed63ed8170e35542aad05dc12c"
+      "1df1edc9f3367fba550b7971fc2de6c5998d8784051c5be69abc9644");
+  const auto pk = getVrfPublicKey(sk);
+  std::vector<VdfSortition> vdfs;
+  std::vector<bytes> vdf_inputs;
+  for (level_t level = 1; level <= 6; ++level) {
+    auto& vdf = vdfs.emplace_back(sortition_params, sk, getRlpBytes(level), 1, 1);
+    vdf_inputs.push_back(blk_hash_t(level).asBytes());
+    // First sortition has no solution, same as in vdf_proof_verify
+    if (level != 1) {
+      vdf.computeVdfSolution(sortition_params, vdf_inputs.back(), false);
+    }
+  }
+  std::vector<VdfVerification> verifications;
+  for (size_t i = 0; i < vdfs.size(); ++i) {
+    verifications.push_back({vdfs[i], sortition_params, getRlpBytes(level_t(i + 1)), pk, vdf_inputs[i], 1, 1});
+  }
+
+  boost::asio::thread_pool pool(2);
+  for (auto* p : {&pool, static_cast<boost::asio::thread_pool*>(nullptr)}) {
+    const auto errors = VdfSortition::verifyVdfs(verifications, p, 2);
+    ASSERT_EQ(errors.size(), vdfs.size());
+    for (size_t i = 0; i < errors.size(); ++i) {
+      EXPECT_EQ(errors[i].has_value(), i == 0);
+    }
+  }
+}
+
 TEST_F(CryptoTest, DISABLED_compute_vdf_solution_cost_time) {
   vrf_sk_t sk(
       "0b6627a6680e01cea3d9f36fa797f7f34e8869c3a526d9ed63ed8170e35542aad05dc12c"
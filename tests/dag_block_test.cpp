@@ -311,6 +311,60 @@ TEST_F(DagBlockMgrTest, dag_block_tips_verification) {
             DagManager::VerifyBlockReturnType::FailedTipsVerification);
 }
 
+TEST_F(DagBlockMgrTest, dag_blocks_batch_verification) {
+  auto node_cfgs = make_node_cfgs(1, 1, 20);
+  auto node = create_nodes(node_cfgs).front();
+
+  auto trxs = samples::createSignedTrxSamples(1, 8, g_secret);
+  for (auto trx : trxs) {
+    auto insert_result = node->getTransactionManager()->insertTransaction(trx);
+    ASSERT_EQ(insert_result.second, "");
+  }
+  auto dag_genesis = node->getConfig().genesis.dag_genesis_block.getHash();
+  SortitionConfig vdf_config(node->getConfig().genesis.sortition);
+  auto propose_level = 1;
+  const auto period_block_hash = node->getDB()->getPeriodBlockHash(propose_level);
+  vdf_sortition::VdfSortition vdf(vdf_config, node->getVrfSecretKey(),
+                                  VrfSortitionBase::makeVrfInput(propose_level, period_block_hash), 1, 1);
+
+  std::vector<std::shared_ptr<DagBlock>> blks;
+  for (auto trx : trxs) {
+    dev::bytes vdf_msg = DagManager::getVdfMessage(dag_genesis, {trx});
+    vdf.computeVdfSolution(vdf_config, vdf_msg, false);
+    blks.push_back(std::make_shared<DagBlock>(dag_genesis, propose_level, vec_blk_t{}, vec_trx_t{trx->getHash()},
+                                              100000, vdf, node->getSecretKey()));
+  }
+  // Sortition made with another VRF key fails VDF verification of the batch only for its block
+  vdf_sortition::VdfSortition foreign_vdf(vdf_config, vrf_wrapper::getVrfKeyPair().second,
+                                          VrfSortitionBase::makeVrfInput(propose_level, period_block_hash), 1, 1);
+  foreign_vdf.computeVdfSolution(vdf_config, DagManager::getVdfMessage(dag_genesis, {trxs[0]}), false);
+  blks.insert(blks.begin() + 2, std::make_shared<DagBlock>(dag_genesis, propose_level, vec_blk_t{},
+                                                           vec_trx_t{trxs[0]->getHash()}, 100000, foreign_vdf,
+                                                           node->getSecretKey()));
+  // Block with duplicate tip fails in the middle of the batch without affecting other blocks
+  blks.insert(blks.begin() + 4,
+              std::make_shared<DagBlock>(dag_genesis, propose_level, vec_blk_t{blks[0]->getHash(), blks[0]->getHash()},
+                                         vec_trx_t{trxs[0]->getHash()}, 100000, vdf, node->getSecretKey()));
+
+  auto results = node->getDagManager()->verifyBlocks(blks);
+  ASSERT_EQ(results.size(), blks.size());
+  for (size_t i = 0; i < blks.size(); ++i) {
+    if (i == 2) {
+      EXPECT_EQ(results[i].first, DagManager::VerifyBlockReturnType::FailedVdfVerification);
+      continue;
+    }
+    if (i == 4) {
+      EXPECT_EQ(results[i].first, DagManager::VerifyBlockReturnType::FailedTipsVerification);
+      continue;
+    }
+    EXPECT_EQ(results[i].first, DagManager::VerifyBlockReturnType::Verified);
+    ASSERT_EQ(results[i].second.size(), 1);
+    EXPECT_EQ(results[i].second[0]->getHash(), blks[i]->getTrxs()[0]);
+    EXPECT_TRUE(node->getDagManager()->addDagBlock(blks[i], std::move(results[i].second)).first);
+  }
+  EXPECT_EQ(node->getDagManager()->getNumVerticesInDag().first, trxs.size() + 1);
+}
+
 TEST_F(DagBlockMgrTest, dag_block_tips_proposal) {
   auto node_cfgs = make_node_cfgs(2, 1, 20);
   auto node = create_nodes(node_cfgs).front();
@@ -1,9 +1,14 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+#include <random>
+
 #include "common/init.hpp"
 #include "common/types.hpp"
 #include "dag/dag_manager.hpp"
 #include "logger/logger.hpp"
+#include "test_util/samples.hpp"
 #include "test_util/test_util.hpp"
 
 namespace taraxa::core_tests {
@@ -129,6 +134,47 @@ TEST_F(DagTest, genesis_get_pivot) {
   EXPECT_EQ(leaves.size(), 1);
 }
 
+TEST_F(DagTest, pivot_tree_ghost_path) {
+  const blk_hash_t GENESIS(1);
+  taraxa::PivotTree graph(GENESIS, addr_t());
+
+  // Subtree of 2 is heavier than subtree of 3 only after 5 is added
+  graph.addVEEs(blk_hash_t(2), GENESIS, {});
+  graph.addVEEs(blk_hash_t(3), GENESIS, {});
+  graph.addVEEs(blk_hash_t(4), blk_hash_t(3), {});
+  EXPECT_EQ(graph.getGhostPath(GENESIS), std::vector<blk_hash_t>({GENESIS, blk_hash_t(3), blk_hash_t(4)}));
+  graph.addVEEs(blk_hash_t(5), blk_hash_t(2), {});
+  EXPECT_EQ(graph.getGhostPath(GENESIS), std::vector<blk_hash_t>({GENESIS, blk_hash_t(2), blk_hash_t(5)}));
+  graph.addVEEs(blk_hash_t(6), blk_hash_t(5), {});
+  graph.addVEEs(blk_hash_t(7), blk_hash_t(4), {});
+  graph.addVEEs(blk_hash_t(8), blk_hash_t(4), {});
+  EXPECT_EQ(graph.getGhostPath(GENESIS),
+            std::vector<blk_hash_t>({GENESIS, blk_hash_t(3), blk_hash_t(4), blk_hash_t(7)}));
+  EXPECT_EQ(graph.getGhostPath(blk_hash_t(2)), std::vector<blk_hash_t>({blk_hash_t(2), blk_hash_t(5), blk_hash_t(6)}));
+
+  // Tree is rebuilt from anchor after period is finalized
+  graph.clear();
+  graph.addVEEs(blk_hash_t(3), {}, {});
+  graph.addVEEs(blk_hash_t(7), blk_hash_t(3), {});
+  graph.addVEEs(blk_hash_t(9), blk_hash_t(3), {});
+  graph.addVEEs(blk_hash_t(10), blk_hash_t(9), {});
+  EXPECT_EQ(graph.getGhostPath(blk_hash_t(3)), std::vector<blk_hash_t>({blk_hash_t(3), blk_hash_t(9), blk_hash_t(10)}));
+
+  // Bulk insertion computes the same weights at once
+  graph.clear();
+  graph.deferWeights();
+  graph.addVEEs(blk_hash_t(3), {}, {});
+  graph.addVEEs(blk_hash_t(7), blk_hash_t(3), {});
+  graph.addVEEs(blk_hash_t(9), blk_hash_t(3), {});
+  graph.addVEEs(blk_hash_t(10), blk_hash_t(9), {});
+  graph.rebuildWeights();
+  EXPECT_EQ(graph.getGhostPath(blk_hash_t(3)), std::vector<blk_hash_t>({blk_hash_t(3), blk_hash_t(9), blk_hash_t(10)}));
+  graph.addVEEs(blk_hash_t(11), blk_hash_t(7), {});
+  graph.addVEEs(blk_hash_t(12), blk_hash_t(11), {});
+  EXPECT_EQ(graph.getGhostPath(blk_hash_t(3)),
+            std::vector<blk_hash_t>({blk_hash_t(3), blk_hash_t(7), blk_hash_t(11), blk_hash_t(12)}));
+}
+
 // Use the example on Conflux paper
 TEST_F(DagTest, compute_epoch) {
   auto db_ptr = std::make_shared<DbStorage>(data_dir / "db");
@@ -323,6 +369,51 @@ TEST_F(DagTest, dag_expiry) {
   EXPECT_TRUE(db_ptr->dagBlockInDb(blk_over_limit->getHash()));
 }
 
+TEST_F(DagTest, add_block_concurrently_with_expiry) {
+  node_cfgs[0].max_levels_per_period = 3;
+  node_cfgs[0].dag_expiry_limit = 3;
+  node_cfgs[0].genesis.pbft.gas_limit = 100000;
+  const blk_hash_t GENESIS = node_cfgs[0].genesis.dag_genesis_block.getHash();
+  const auto trx = samples::createSignedTrxSamples(1, 1, dev::KeyPair::create().secret()).front();
+
+  // Block is added while finalization expires other block with the same transaction, transaction must be kept for the
+  // added block regardless of which of them gets mutex first
+  for (uint32_t i = 0; i < 10; ++i) {
+    auto db_ptr = std::make_shared<DbStorage>(data_dir / ("db" + std::to_string(i)));
+    auto trx_mgr = std::make_shared<TransactionManager>(FullNodeConfig(), db_ptr, nullptr, addr_t());
+    auto pbft_chain = std::make_shared<PbftChain>(addr_t(), db_ptr);
+    auto mgr = std::make_shared<DagManager>(node_cfgs[0], addr_t(), trx_mgr, pbft_chain, nullptr, db_ptr, nullptr);
+
+    auto expiring = std::make_shared<DagBlock>(GENESIS, 1, vec_blk_t{}, vec_trx_t{trx->getHash()}, sig_t(1),
+                                               blk_hash_t(100), addr_t(1));
+    EXPECT_TRUE(mgr->addDagBlock(expiring, {trx}).first);
+    // Pivot chain of levels 1 to 6, last block is anchor
+    blk_hash_t pivot = GENESIS;
+    for (level_t level = 1; level <= 6; ++level) {
+      auto blk = std::make_shared<DagBlock>(pivot, level, vec_blk_t{}, vec_trx_t{}, sig_t(1), blk_hash_t(level),
+                                            addr_t(1));
+      EXPECT_TRUE(mgr->addDagBlock(blk).first);
+      pivot = blk->getHash();
+    }
+    const auto anchor = pivot;
+    const auto order = mgr->getDagBlockOrder(anchor, 1);
+    auto added = std::make_shared<DagBlock>(blk_hash_t(5), 6, vec_blk_t{}, vec_trx_t{trx->getHash()}, sig_t(1),
+                                            blk_hash_t(200), addr_t(1));
+
+    std::thread finalization([&] {
+      std::unique_lock dag_lock(mgr->getDagMutex());
+      std::unique_lock trx_lock(trx_mgr->getTransactionsMutex());
+      mgr->setDagBlockOrder(anchor, 1, order);
+    });
+    EXPECT_TRUE(mgr->addDagBlock(added, {trx}).first);
+    finalization.join();
+
+    EXPECT_FALSE(db_ptr->dagBlockInDb(expiring->getHash()));
+    EXPECT_TRUE(db_ptr->dagBlockInDb(added->getHash()));
+    EXPECT_TRUE(db_ptr->transactionInDb(trx->getHash()));
+  }
+}
+
 TEST_F(DagTest, receive_block_in_order) {
   auto db_ptr = std::make_shared<DbStorage>(data_dir / "db");
   auto pbft_chain = std::make_shared<PbftChain>(addr_t(), db_ptr);
@@ -491,6 +582,51 @@ TEST_F(DagTest, initial_pivot) {
   EXPECT_TRUE(pt->second.empty());
   EXPECT_EQ(pt->first, node_cfgs[0].genesis.dag_genesis_block.getHash());
 }
+
+TEST_F(DagTest, DISABLED_compute_order_and_ghost_path_benchmark) {
+  const blk_hash_t GENESIS(1);
+  const size_t kVerticesCount = 100000;
+  const size_t kBlocksPerLevel = 10;
+  taraxa::Dag dag(GENESIS, addr_t());
+  taraxa::PivotTree pivot_tree(GENESIS, addr_t());
+
+  // Every block points to random pivot and tips among recent blocks, as it does on high dag rate
+  std::mt19937 rng(1);
+  std::vector<blk_hash_t> blocks{GENESIS};
+  std::map<uint64_t, std::unordered_set<blk_hash_t>> non_finalized_blks;
+  for (size_t i = 0; i < kVerticesCount; ++i) {
+    const auto recent = std::min<size_t>(blocks.size(), 2 * kBlocksPerLevel);
+    const auto pivot = blocks[blocks.size() - 1 - rng() % recent];
+    std::vector<blk_hash_t> tips;
+    for (size_t t = rng() % 3; t > 0; --t) {
+      tips.push_back(blocks[blocks.size() - 1 - rng() % recent]);
+    }
+    const blk_hash_t hash(i + 2);
+    dag.addVEEs(hash, pivot, tips);
+    pivot_tree.addVEEs(hash, pivot, {});
+    blocks.push_back(hash);
+    non_finalized_blks[i / kBlocksPerLevel + 1].insert(hash);
+  }
+  EXPECT_EQ(dag.getNumVertices(), kVerticesCount + 1);
+
+  auto now = std::chrono::steady_clock::now();
+  const auto ghost_path = pivot_tree.getGhostPath(GENESIS);
+  std::cout << "Time to get ghost path of " << kVerticesCount << " vertices: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - now).count()
+            << "ms" << std::endl;
+  ASSERT_GT(ghost_path.size(), 1);
+  EXPECT_EQ(ghost_path.front(), GENESIS);
+
+  std::vector<blk_hash_t> order;
+  now = std::chrono::steady_clock::now();
+  EXPECT_TRUE(dag.computeOrder(ghost_path.back(), order, non_finalized_blks));
+  std::cout << "Time to compute order of " << kVerticesCount << " vertices: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - now).count()
+            << "ms" << std::endl;
+  ASSERT_FALSE(order.empty());
+  EXPECT_NE(std::find(order.begin(), order.end(), ghost_path.back()), order.end());
+  EXPECT_EQ(std::unordered_set<blk_hash_t>(order.begin(), order.end()).size(), order.size());
+}
 }  // namespace taraxa::core_tests
 
 using namespace taraxa;
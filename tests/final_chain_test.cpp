@@ -1,5 +1,6 @@
 #include "final_chain/final_chain.hpp"
 
+#include <map>
 #include <optional>
 #include <vector>
 
@@ -294,6 +295,223 @@ TEST_F(FinalChainTest, coin_transfers) {
   });
 }
 
+TEST_F(FinalChainTest, batched_state_reads) {
+  constexpr size_t NUM_ACCS = 4;
+  cfg.genesis.state.initial_balances = {};
+  std::vector<addr_t> addrs;
+  for (size_t i = 0; i < NUM_ACCS; ++i) {
+    const auto& addr = addrs.emplace_back(addr_t::random());
+    cfg.genesis.state.initial_balances[addr] = 1000000 * (i + 1);
+  }
+  const auto sender_keys = dev::KeyPair::create();
+  cfg.genesis.state.initial_balances[sender_keys.address()] = u256("10000000000000000000000");
+  init();
+  // Empty blocks don't read accounts, so nothing is cached for them
+  advance({});
+  advance({});
+
+  net::rpc::eth::EthParams eth_rpc_params;
+  eth_rpc_params.chain_id = cfg.genesis.chain_id;
+  eth_rpc_params.gas_limit = cfg.genesis.dag.gas_limit;
+  eth_rpc_params.final_chain = SUT;
+  auto eth_json_rpc = net::rpc::eth::NewEth(std::move(eth_rpc_params));
+
+  const auto accounts_stats = [&] {
+    for (const auto& [cache, stats] : SUT->cachesStats()) {
+      if (cache == "accounts") {
+        return stats;
+      }
+    }
+    return CacheStats{};
+  };
+
+  Json::Value requests(Json::arrayValue);
+  const auto add_request = [&](const std::string& method, const Json::Value& params) {
+    Json::Value req(Json::objectValue);
+    req["jsonrpc"] = "2.0";
+    req["method"] = method;
+    req["params"] = params;
+    requests.append(req);
+  };
+  for (size_t i = 0; i < 3; ++i) {
+    Json::Value params(Json::arrayValue);
+    params.append(dev::toJS(addrs[i]));
+    params.append("0x1");
+    add_request(i % 2 ? "eth_getTransactionCount" : "eth_getBalance", params);
+  }
+  // Invalid requests are skipped by prefetcher
+  add_request("eth_getBalance", Json::Value(Json::arrayValue));
+  add_request("eth_getBalance", Json::Value("0x1"));
+  eth_json_rpc->prefetch_batch(requests);
+
+  // Accounts of batch requests were read by prefetcher, so they are got from cache
+  const auto stats_before = accounts_stats();
+  const auto prefetched = SUT->getAccounts({addrs[0], addrs[1], addrs[2]}, 1);
+  EXPECT_EQ(accounts_stats().misses, stats_before.misses);
+  EXPECT_EQ(accounts_stats().hits, stats_before.hits + 3);
+  for (size_t i = 0; i < prefetched.size(); ++i) {
+    ASSERT_TRUE(prefetched[i]);
+    EXPECT_EQ(prefetched[i]->balance, 1000000 * (i + 1));
+  }
+
+  // Batched read returns the same as single reads, missing accounts included
+  const std::vector<addr_t> to_read = {addrs[3], addr_t::random(), addrs[0], addrs[3]};
+  const auto accounts = SUT->getAccounts(to_read, 2);
+  ASSERT_EQ(accounts.size(), to_read.size());
+  for (size_t i = 0; i < to_read.size(); ++i) {
+    const auto account = SUT->getAccount(to_read[i], 2);
+    ASSERT_EQ(accounts[i].has_value(), account.has_value());
+    if (account) {
+      EXPECT_EQ(util::rlp_enc(*accounts[i]), util::rlp_enc(*account));
+    }
+  }
+  EXPECT_FALSE(accounts[1]);
+  EXPECT_TRUE(SUT->getAccounts({}, 2).empty());
+
+  auto trx = std::make_shared<Transaction>(0, 0, 0, 1000000, dev::fromHex(samples::greeter_contract_code),
+                                           sender_keys.secret());
+  const auto contract_addr = *advance({trx})->trx_receipts[0].new_contract_address;
+  const std::vector<u256> keys = {0, 1, 2};
+  const auto storages = SUT->getAccountStorages(contract_addr, keys);
+  ASSERT_EQ(storages.size(), keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_EQ(storages[i], SUT->getAccountStorage(contract_addr, keys[i]));
+  }
+  // Greeting is saved in the first slot by constructor
+  EXPECT_NE(storages[0], h256());
+}
+
+TEST_F(FinalChainTest, prefetched_state_execution) {
+  const auto sender_keys = dev::KeyPair::create();
+  const auto& sender = sender_keys.address();
+  const std::vector<addr_t> receivers = {addr_t::random(), addr_t::random()};
+  const auto contract_addr = dev::right160(dev::sha3(dev::rlpList(sender, 0)));
+  cfg.genesis.state.initial_balances = {};
+  cfg.genesis.state.initial_balances[sender] = u256("10000000000000000000000");
+  // init sets it after the first chain is created, so both chains are created with the same genesis
+  cfg.genesis.state.dpos.yield_percentage = 0;
+
+  const auto transfer = [&](uint64_t nonce, const addr_t& to) {
+    return std::make_shared<Transaction>(nonce, 100 + nonce, 0, 100000, dev::bytes(), sender_keys.secret(), to);
+  };
+  const std::vector<SharedTransactions> blocks = {
+      {std::make_shared<Transaction>(0, 0, 0, 1000000, dev::fromHex(samples::greeter_contract_code),
+                                     sender_keys.secret()),
+       transfer(1, receivers[0]), transfer(2, receivers[1])},
+      {std::make_shared<Transaction>(3, 0, 0, 1000000,
+                                     // setGreeting("Hola")
+                                     dev::fromHex("0xa4136862000000000000000000000000000000000000000000000000"
+                                                  "00000000000000200000000000000000000000000000000000000000000"
+                                                  "000000000000000000004486f6c61000000000000000000000000000000"
+                                                  "00000000000000000000000000"),
+                                     sender_keys.secret(), contract_addr),
+       transfer(4, receivers[0])},
+  };
+  const std::vector<addr_t> addrs = {sender, receivers[0], receivers[1], contract_addr};
+  const std::vector<u256> keys = {0, 1};
+
+  // Executes the same blocks on a new db and returns state roots, receipts, accounts and contract storage
+  const auto execute = [&](uint32_t prefetch_threads, const std::string& db_dir) {
+    cfg.final_chain_prefetch_threads = prefetch_threads;
+    SUT.reset();
+    db = std::make_shared<DbStorage>(data_dir / db_dir);
+    expected_blk_num = 0;
+    expected_balances.clear();
+    init();
+    std::vector<bytes> results;
+    for (const auto& trxs : blocks) {
+      const auto result = advance(trxs, {.dont_assume_no_logs = true});
+      results.push_back(result->final_chain_blk->state_root.asBytes());
+      results.push_back(result->final_chain_blk->receipts_root.asBytes());
+    }
+    for (const auto& account : SUT->getAccounts(addrs)) {
+      EXPECT_TRUE(account);
+      results.push_back(account ? util::rlp_enc(*account) : bytes());
+    }
+    for (const auto& value : SUT->getAccountStorages(contract_addr, keys)) {
+      results.push_back(value.asBytes());
+    }
+    return results;
+  };
+
+  const auto not_prefetched = execute(0, "db_not_prefetched");
+  const auto prefetched = execute(4, "db_prefetched");
+  EXPECT_EQ(prefetched, not_prefetched);
+}
+
+TEST_F(FinalChainTest, receipts_by_block) {
+  const auto sender_keys = dev::KeyPair::create();
+  cfg.genesis.state.initial_balances = {};
+  cfg.genesis.state.initial_balances[sender_keys.address()] = taraxa::uint256_t("0x204FCE5E3E25026110000000");
+  cfg.db_config.receipts_by_block = true;
+  init();
+
+  constexpr auto TRX_GAS = 100000;
+  SharedTransactions trxs;
+  for (uint64_t nonce = 0; nonce < 3; ++nonce) {
+    trxs.push_back(std::make_shared<Transaction>(nonce, 100 + nonce, 0, TRX_GAS, dev::bytes(), sender_keys.secret(),
+                                                 addr_t::random()));
+  }
+  // advance checks that every receipt is found by transaction hash
+  const auto result = advance(trxs);
+  const auto blk_n = result->final_chain_blk->number;
+
+  EXPECT_TRUE(db->lookup(trxs[0]->getHash(), DbStorage::Columns::final_chain_receipt_by_trx_hash).empty());
+  const auto block_receipts = SUT->blockReceipts(blk_n);
+  ASSERT_EQ(block_receipts.size(), trxs.size());
+  std::vector<h256> hashes = {trxs[2]->getHash(), h256::random(), trxs[0]->getHash()};
+  const auto receipts = SUT->transactionReceipts(hashes);
+  ASSERT_TRUE(receipts[0] && receipts[2]);
+  EXPECT_FALSE(receipts[1]);
+  EXPECT_EQ(util::rlp_enc(*receipts[0]), util::rlp_enc(block_receipts[2]));
+  EXPECT_EQ(util::rlp_enc(*receipts[2]), util::rlp_enc(block_receipts[0]));
+  for (size_t i = 0; i < trxs.size(); ++i) {
+    EXPECT_EQ(util::rlp_enc(block_receipts[i]), util::rlp_enc(result->trx_receipts[i]));
+  }
+  EXPECT_TRUE(SUT->blockReceipts(blk_n + 1).empty());
+}
+
+TEST_F(FinalChainTest, receipts_blob_decoding) {
+  std::vector<bytes> receipts_rlp;
+  for (uint64_t i = 0; i < 3; ++i) {
+    TransactionReceipt receipt;
+    receipt.status_code = 1;
+    receipt.gas_used = 21000 + i;
+    receipt.cumulative_gas_used = 21000 * (i + 1);
+    receipt.logs.push_back({addr_t::random(), {h256::random()}, bytes(i, 1)});
+    receipts_rlp.push_back(util::rlp_enc(receipt));
+  }
+  const auto blob = encodeReceiptsBlob(receipts_rlp);
+  // Receipts count is stored big endian
+  EXPECT_EQ(bytes(blob.begin(), blob.begin() + 4), bytes({0, 0, 0, 3}));
+
+  const auto receipts = decodeReceiptsBlob(&blob);
+  ASSERT_EQ(receipts.size(), receipts_rlp.size());
+  for (size_t i = 0; i < receipts_rlp.size(); ++i) {
+    EXPECT_EQ(util::rlp_enc(receipts[i]), receipts_rlp[i]);
+    EXPECT_EQ(util::rlp_enc(*decodeReceiptFromBlob(&blob, i)), receipts_rlp[i]);
+  }
+  EXPECT_FALSE(decodeReceiptFromBlob(&blob, receipts_rlp.size()));
+  EXPECT_TRUE(decodeReceiptsBlob({}).empty());
+  const auto empty_blob = encodeReceiptsBlob({});
+  EXPECT_TRUE(decodeReceiptsBlob(&empty_blob).empty());
+
+  // Truncated count, offsets table or receipts data
+  for (size_t size : {size_t(2), size_t(8), blob.size() - 1}) {
+    EXPECT_THROW(decodeReceiptsBlob(bytesConstRef(blob.data(), size)), std::runtime_error);
+    EXPECT_THROW(decodeReceiptFromBlob(bytesConstRef(blob.data(), size), 0), std::runtime_error);
+  }
+  // Receipts count over the blob size
+  auto malformed = blob;
+  malformed[0] = 0xff;
+  EXPECT_THROW(decodeReceiptsBlob(&malformed), std::runtime_error);
+  // Offset of the first receipt end is after the second one
+  malformed = blob;
+  malformed[4] = 0xff;
+  EXPECT_THROW(decodeReceiptsBlob(&malformed), std::runtime_error);
+  EXPECT_THROW(decodeReceiptFromBlob(&malformed, 1), std::runtime_error);
+}
+
 TEST_F(FinalChainTest, initial_validators) {
   const dev::KeyPair key = dev::KeyPair::create();
   const std::vector<dev::KeyPair> validator_keys = {dev::KeyPair::create(), dev::KeyPair::create(),
@@ -662,6 +880,7 @@ TEST_F(FinalChainTest, get_logs_multiple_topics) {
   const auto& sk = sender_keys.secret();
   cfg.genesis.state.initial_balances = {};
   cfg.genesis.state.initial_balances[from] = u256("10000000000000000000000");
+  cfg.db_config.log_index = true;
   init();
 
   net::rpc::eth::EthParams eth_rpc_params;
@@ -721,6 +940,37 @@ TEST_F(FinalChainTest, get_logs_multiple_topics) {
     auto res = eth_json_rpc->eth_getLogs(logs_obj);
     ASSERT_EQ(res.size(), 3);
   }
+  {
+    const auto blocks = SUT->withLogIndex({*contract_addr}, {h256(topic1), h256(topic2)}, from_block, expected_blk_num);
+    ASSERT_TRUE(blocks);
+    ASSERT_EQ(*blocks, std::vector<EthBlockNumber>({from_block + 1, from_block + 2, from_block + 3}));
+  }
+
+  // Log index is rebuilt in background, queries use blooms until it is complete
+  SUT->stop();
+  SUT.reset();
+  cfg.db_config.rebuild_log_index = true;
+  SUT = std::make_shared<final_chain::FinalChain>(db, cfg, addr_t{});
+  EXPECT_HAPPENS({10s, 100ms}, [&](auto& ctx) {
+    WAIT_EXPECT_TRUE(ctx, SUT->withLogIndex({*contract_addr}, {}, 0, expected_blk_num).has_value())
+  });
+  {
+    const auto blocks = SUT->withLogIndex({*contract_addr}, {h256(topic1), h256(topic2)}, from_block, expected_blk_num);
+    ASSERT_TRUE(blocks);
+    ASSERT_EQ(*blocks, std::vector<EthBlockNumber>({from_block + 1, from_block + 2, from_block + 3}));
+  }
+
+  // Log index of pruned blocks is pruned with their period data
+  db->clearPeriodDataHistory(from_block + 2, 0);
+  EXPECT_HAPPENS({10s, 100ms}, [&](auto& ctx) {
+    const auto pruning_stats = db->getPruningStats();
+    WAIT_EXPECT_GE(ctx, pruning_stats.period_cursor, pruning_stats.period_target)
+  });
+  {
+    const auto blocks = SUT->withLogIndex({*contract_addr}, {h256(topic1), h256(topic2)}, 0, expected_blk_num);
+    ASSERT_TRUE(blocks);
+    ASSERT_EQ(*blocks, std::vector<EthBlockNumber>({from_block + 2, from_block + 3}));
+  }
 }
 
 TEST_F(FinalChainTest, topics_size_limit) {
@@ -744,6 +994,57 @@ TEST_F(FinalChainTest, topics_size_limit) {
   EXPECT_THROW(eth_json_rpc->eth_getLogs(logs_obj), jsonrpc::JsonRpcException);
 }
 
+TEST_F(FinalChainTest, bloom_contains) {
+  LogBloom part, other;
+  part.shiftBloom<3>(dev::sha3(addr_t::random().ref()));
+  other.shiftBloom<3>(dev::sha3(addr_t::random().ref()));
+  EXPECT_FALSE(bloomContains(LogBloom(), part));
+  EXPECT_TRUE(bloomContains(part | other, part));
+  EXPECT_TRUE(bloomContains(part, LogBloom()));
+  EXPECT_EQ(bloomContains(other, part), other.contains(part));
+}
+
+TEST_F(FinalChainTest, parallel_bloom_query) {
+  init();
+
+  // Blocks are far apart, so sub-ranges of parallel query have matches. Index chunks are written as by appendBlock
+  LogBloom bloom, other;
+  bloom.shiftBloom<3>(dev::sha3(addr_t::random().ref()));
+  other.shiftBloom<3>(dev::sha3(addr_t::random().ref()));
+  const std::vector<EthBlockNumber> matching = {5, 300, 301, 9000, 20000, 40000, 65535, 65536, 70000, 79999};
+  const std::vector<EthBlockNumber> not_matching = {6, 302, 30000, 70001};
+  std::map<h256, BlocksBlooms> chunks;
+  for (const auto& [blocks, blk_bloom] : {std::pair{matching, bloom | other}, std::pair{not_matching, other}}) {
+    for (const auto blk_n : blocks) {
+      for (uint64_t level = 0, index = blk_n; level < c_bloomIndexLevels; ++level, index /= c_bloomIndexSize) {
+        chunks[blockBloomsChunkId(level, index / c_bloomIndexSize)][index % c_bloomIndexSize] |= blk_bloom;
+      }
+    }
+  }
+  auto batch = db->createWriteBatch();
+  for (const auto& [chunk_id, chunk] : chunks) {
+    db->insert(batch, DbStorage::Columns::final_chain_log_blooms_index, chunk_id, util::rlp_enc(chunk));
+  }
+  db->commitWriteBatch(batch);
+
+  // Ranges of less than 64 top level chunks are searched by single thread
+  const auto single_threaded = [&](EthBlockNumber from, EthBlockNumber to) {
+    const EthBlockNumber step = 32 * c_bloomIndexSize * c_bloomIndexSize;
+    std::vector<EthBlockNumber> ret;
+    for (auto sub_from = from; sub_from <= to; sub_from += step) {
+      dev::operator+=(ret, SUT->withBlockBloom(bloom, sub_from, std::min(to, sub_from + step - 1)));
+    }
+    return ret;
+  };
+  for (const auto& [from, to] : {std::pair<EthBlockNumber, EthBlockNumber>{1, 80000}, {301, 70000}, {6, 65535}}) {
+    std::vector<EthBlockNumber> expected;
+    std::copy_if(matching.begin(), matching.end(), std::back_inserter(expected),
+                 [from, to](auto blk_n) { return blk_n >= from && blk_n <= to; });
+    EXPECT_EQ(single_threaded(from, to), expected);
+    EXPECT_EQ(SUT->withBlockBloom(bloom, from, to), expected);
+  }
+}
+
 TEST_F(FinalChainTest, fee_rewards_distribution) {
   auto sender_keys = dev::KeyPair::create();
   auto gas = 30000;
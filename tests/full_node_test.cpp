@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 
 #include <atomic>
+#include <future>
 #include <iostream>
 #include <mutex>
 #include <shared_mutex>
@@ -22,6 +23,7 @@
 #include "network/rpc/Taraxa.h"
 #include "node/node.hpp"
 #include "pbft/pbft_manager.hpp"
+#include "storage/migration/period_data_head.hpp"
 #include "test_util/samples.hpp"
 #include "transaction/transaction_manager.hpp"
 
@@ -68,6 +70,11 @@ TEST_F(FullNodeTest, db_test) {
   EXPECT_EQ(*blk1, *db.getDagBlock(blk1->getHash()));
   EXPECT_EQ(*blk2, *db.getDagBlock(blk2->getHash()));
   EXPECT_EQ(*blk3, *db.getDagBlock(blk3->getHash()));
+  const auto blks = db.getDagBlocks({blk3->getHash(), blk_hash_t(12345), blk1->getHash()});
+  ASSERT_EQ(blks.size(), 3);
+  EXPECT_EQ(*blk3, *blks[0]);
+  EXPECT_EQ(blks[1], nullptr);
+  EXPECT_EQ(*blk1, *blks[2]);
   std::set<blk_hash_t> s1, s2;
   s1.emplace(blk1->getHash());
   s1.emplace(blk2->getHash());
@@ -90,6 +97,16 @@ TEST_F(FullNodeTest, db_test) {
   ASSERT_EQ(*g_trx_signed_samples[1], *db.getTransaction(g_trx_signed_samples[1]->getHash()));
   ASSERT_EQ(*g_trx_signed_samples[2], *db.getTransaction(g_trx_signed_samples[2]->getHash()));
   ASSERT_EQ(*g_trx_signed_samples[3], *db.getTransaction(g_trx_signed_samples[3]->getHash()));
+  // Batched reads keep order of provided hashes and report missing ones
+  const std::vector<trx_hash_t> trx_hashes{g_trx_signed_samples[2]->getHash(), g_trx_signed_samples[4]->getHash(),
+                                           g_trx_signed_samples[0]->getHash()};
+  EXPECT_EQ(db.transactionsInDb(trx_hashes), std::vector<bool>({true, false, true}));
+  EXPECT_EQ(db.transactionsFinalized(trx_hashes), std::vector<bool>({false, false, false}));
+  const auto trxs = db.getTransactions(trx_hashes);
+  ASSERT_EQ(trxs.size(), 3);
+  EXPECT_EQ(*g_trx_signed_samples[2], *trxs[0]);
+  EXPECT_EQ(trxs[1], nullptr);
+  EXPECT_EQ(*g_trx_signed_samples[0], *trxs[2]);
 
   // PBFT manager round and step
   EXPECT_EQ(db.getPbftMgrField(PbftMgrField::Round), 1);
@@ -173,6 +190,8 @@ TEST_F(FullNodeTest, db_test) {
   PeriodData period_data2(pbft_block2, votes);
   PeriodData period_data3(pbft_block3, votes);
   PeriodData period_data4(pbft_block4, votes);
+  period_data2.dag_blocks = {blk1, blk2};
+  period_data3.dag_blocks = {blk3};
 
   batch = db.createWriteBatch();
   db.savePeriodData(period_data1, batch);
@@ -189,6 +208,16 @@ TEST_F(FullNodeTest, db_test) {
   EXPECT_EQ(db.getPbftBlock(pbft_block2->getBlockHash())->rlp(false), pbft_block2->rlp(false));
   EXPECT_EQ(db.getPbftBlock(pbft_block3->getBlockHash())->rlp(false), pbft_block3->rlp(false));
   EXPECT_EQ(db.getPbftBlock(pbft_block4->getBlockHash())->rlp(false), pbft_block4->rlp(false));
+  const auto period_blks = db.getFinalizedDagBlockByPeriods({pbft_block3->getPeriod(), 100, pbft_block2->getPeriod()});
+  ASSERT_EQ(period_blks.size(), 3);
+  ASSERT_EQ(period_blks[0].size(), 1);
+  EXPECT_EQ(*blk3, *period_blks[0][0]);
+  EXPECT_TRUE(period_blks[1].empty());
+  ASSERT_EQ(period_blks[2].size(), 2);
+  EXPECT_EQ(*blk1, *period_blks[2][0]);
+  EXPECT_EQ(*blk2, *period_blks[2][1]);
+  EXPECT_EQ(db.getFinalizedDagBlockByPeriod(pbft_block2->getPeriod()).size(), 2);
+  EXPECT_EQ(*blk3, *db.getDagBlock(blk3->getHash()));
 
   auto cert_votes_from_db = db.getPeriodCertVotes(pbft_block1->getPeriod());
   auto pillar_votes_from_db = db.getPeriodPillarVotes(pbft_block1->getPeriod());
@@ -351,6 +380,172 @@ TEST_F(FullNodeTest, db_test) {
   EXPECT_FALSE(db.getProposalPeriodForDagLevel(107));
 }
 
+TEST_F(FullNodeTest, db_column_profiles) {
+  RocksDbConfig rocksdb_config;
+  auto &profile = rocksdb_config.profiles["point_lookup"];
+  profile.bloom_bits_per_key = 10;
+  profile.block_size_kb = 16;
+  profile.block_cache_mb = 8;
+  profile.compression_per_level = {"none", "lz4"};
+  rocksdb_config.columns[DbStorage::Columns::transactions.name()] = "point_lookup";
+  rocksdb_config.columns[DbStorage::Columns::trx_period.name()] = "point_lookup";
+
+  auto db = std::make_shared<DbStorage>(data_dir, 0, 0, 0, 0, addr_t(), false, rocksdb_config);
+  auto batch = db->createWriteBatch();
+  db->addTransactionToBatch(*g_trx_signed_samples[0], batch);
+  db->commitWriteBatch(batch);
+  EXPECT_EQ(*g_trx_signed_samples[0], *db->getTransaction(g_trx_signed_samples[0]->getHash()));
+
+  const auto stats = db->getColumnsStats();
+  ASSERT_EQ(stats.size(), DbStorage::Columns::all.size());
+  const auto &trx_stats = stats[DbStorage::Columns::transactions.ordinal_];
+  const auto &trx_period_stats = stats[DbStorage::Columns::trx_period.ordinal_];
+  EXPECT_EQ(trx_stats.profile, "point_lookup");
+  EXPECT_EQ(trx_stats.bloom_bits_per_key, 10);
+  EXPECT_EQ(trx_stats.block_size, 16 * 1024);
+  EXPECT_EQ(trx_stats.block_cache_capacity, 8 * 1024 * 1024);
+  // Columns with the same profile share block cache
+  EXPECT_EQ(trx_stats.block_cache_capacity, trx_period_stats.block_cache_capacity);
+  EXPECT_TRUE(stats[DbStorage::Columns::period_data.ordinal_].profile.empty());
+}
+
+TEST_F(FullNodeTest, db_shared_caches) {
+  RocksDbConfig rocksdb_config;
+  rocksdb_config.block_cache_mb = 16;
+  rocksdb_config.row_cache_mb = 4;
+  rocksdb_config.profiles["point_lookup"].bloom_bits_per_key = 10;
+  rocksdb_config.columns[DbStorage::Columns::transactions.name()] = "point_lookup";
+
+  auto db = std::make_shared<DbStorage>(data_dir, 0, 0, 0, 0, addr_t(), false, rocksdb_config);
+  const auto cache_stats = db->getCacheStats();
+  EXPECT_EQ(cache_stats.block_cache_capacity, 16 * 1024 * 1024);
+  EXPECT_EQ(cache_stats.row_cache_capacity, 4 * 1024 * 1024);
+
+  // Both columns with profile without own cache and columns without profile use shared block cache
+  const auto stats = db->getColumnsStats();
+  EXPECT_EQ(stats[DbStorage::Columns::transactions.ordinal_].block_cache_capacity, 16 * 1024 * 1024);
+  EXPECT_EQ(stats[DbStorage::Columns::period_data.ordinal_].block_cache_capacity, 16 * 1024 * 1024);
+}
+
+TEST_F(FullNodeTest, db_period_data_head_migration) {
+  auto db = std::make_shared<DbStorage>(data_dir);
+  auto pbft_block = make_simple_pbft_block(blk_hash_t(1), 2);
+  std::vector<std::shared_ptr<PbftVote>> cert_votes{
+      genDummyVote(PbftVoteTypes::cert_vote, 2, 2, 3, pbft_block->getBlockHash())};
+  PeriodData period_data(pbft_block, cert_votes);
+  period_data.dag_blocks.push_back(std::make_shared<DagBlock>(
+      blk_hash_t(2), 1, vec_blk_t{}, vec_trx_t{g_trx_signed_samples[0]->getHash()}, secret_t::random()));
+  period_data.transactions.push_back(g_trx_signed_samples[0]);
+  const auto period = pbft_block->getPeriod();
+
+  auto batch = db->createWriteBatch();
+  db->savePeriodData(period_data, batch);
+  db->commitWriteBatch(batch);
+  // Head leaves dag blocks and transactions out
+  EXPECT_LT(db->lookup(period, DbStorage::Columns::period_data_head).size(), db->getPeriodDataRaw(period).size());
+
+  // Db written before head column existed has only full period data
+  db->remove(DbStorage::Columns::period_data_head, period);
+  EXPECT_FALSE(db->getPbftBlock(period));
+
+  auto log = logger::createLogger(logger::Verbosity::Error, "MIGRATE", addr_t());
+  storage::migration::PeriodDataHead(db).apply(log);
+  EXPECT_EQ(db->getPbftBlock(period)->rlp(false), pbft_block->rlp(false));
+  const auto cert_votes_from_db = db->getPeriodCertVotes(period);
+  ASSERT_EQ(cert_votes_from_db.size(), 1);
+  EXPECT_EQ(cert_votes_from_db.front()->getHash(), cert_votes.front()->getHash());
+  EXPECT_EQ(db->getPeriodData(period)->rlp(), period_data.rlp());
+}
+
+TEST_F(FullNodeTest, db_snapshots_incremental_backup) {
+  const auto node_path = data_dir / "node";
+  const auto backup_path = data_dir / "backup";
+  Json::Value manifests(Json::arrayValue);
+  {
+    auto db = std::make_shared<DbStorage>(node_path, 1, 0, 0, 0, addr_t(), false);
+    db->enableSnapshotsBackup(backup_path, 0);
+    for (PbftPeriod period = 1; period <= 2; ++period) {
+      auto batch = db->createWriteBatch();
+      db->addTransactionToBatch(*g_trx_signed_samples[period], batch);
+      db->commitWriteBatch(batch);
+      // Checkpoint flushes memtable, so each snapshot adds a new sst file
+      ASSERT_TRUE(db->createSnapshot(period));
+      // State db is not used by this test, its snapshot is an empty directory
+      fs::create_directories(db->stateDbStoragePath().string() + std::to_string(period));
+      db->scheduleSnapshotBackup(period);
+
+      const auto manifest_path = backup_path / ("snapshot" + std::to_string(period) + ".json");
+      ASSERT_HAPPENS({10s, 100ms}, [&](auto &ctx) { WAIT_EXPECT_TRUE(ctx, fs::exists(manifest_path)) });
+      manifests.append(util::readJsonFromFile(manifest_path.string()));
+    }
+  }
+
+  // Sst files of the first snapshot are not copied again
+  const auto &first = manifests[0]["db"];
+  const auto &second = manifests[1]["db"];
+  ASSERT_FALSE(first["added"].empty());
+  ASSERT_FALSE(second["added"].empty());
+  EXPECT_LT(second["added"].size(), second["shared"].size());
+  for (const auto &added : second["added"]) {
+    for (const auto &shared : first["shared"]) {
+      EXPECT_NE(added.asString(), shared["shared"].asString());
+    }
+  }
+
+  // Db is restored from shared sst files and files of the second snapshot
+  const auto restore_path = data_dir / "restore";
+  fs::create_directories(restore_path / "db");
+  for (const auto &shared : second["shared"]) {
+    fs::copy_file(backup_path / "shared" / "db" / shared["shared"].asString(),
+                  restore_path / "db" / shared["name"].asString());
+  }
+  for (const auto &file : second["files"]) {
+    fs::copy_file(backup_path / "db2" / file.asString(), restore_path / "db" / file.asString());
+  }
+  auto restored = std::make_shared<DbStorage>(restore_path);
+  for (size_t i = 1; i <= 2; ++i) {
+    EXPECT_EQ(*restored->getTransaction(g_trx_signed_samples[i]->getHash()), *g_trx_signed_samples[i]);
+  }
+}
+
+TEST_F(FullNodeTest, db_snapshots_backup_hook) {
+  const auto backup_path = data_dir / "backup";
+  std::mutex hook_calls_mutex;
+  std::vector<std::pair<PbftPeriod, fs::path>> hook_calls;
+  std::promise<void> release_hook;
+  const auto hook_released = release_hook.get_future().share();
+
+  auto db = std::make_shared<DbStorage>(data_dir / "node", 1, 0, 0, 0, addr_t(), false);
+  db->enableSnapshotsBackup(backup_path, 0);
+  db->setSnapshotBackupHook([&](PbftPeriod period, const fs::path &manifest_path) {
+    hook_released.wait();
+    std::unique_lock lock(hook_calls_mutex);
+    hook_calls.emplace_back(period, manifest_path);
+  });
+  for (PbftPeriod period = 1; period <= 2; ++period) {
+    EXPECT_TRUE(db->createSnapshot(period));
+    fs::create_directories(db->stateDbStoragePath().string() + std::to_string(period));
+    db->scheduleSnapshotBackup(period);
+  }
+
+  // Hook of the first snapshot is blocked, but it doesn't hold up backup of the next one
+  EXPECT_HAPPENS({10s, 100ms}, [&](auto &ctx) { WAIT_EXPECT_TRUE(ctx, fs::exists(backup_path / "snapshot2.json")) });
+  release_hook.set_value();
+
+  EXPECT_HAPPENS({10s, 100ms}, [&](auto &ctx) {
+    std::unique_lock lock(hook_calls_mutex);
+    WAIT_EXPECT_EQ(ctx, hook_calls.size(), 2)
+  });
+  std::unique_lock lock(hook_calls_mutex);
+  ASSERT_EQ(hook_calls.size(), 2);
+  for (PbftPeriod period = 1; period <= 2; ++period) {
+    const auto &[hook_period, manifest_path] = hook_calls[period - 1];
+    EXPECT_EQ(hook_period, period);
+    EXPECT_EQ(manifest_path, backup_path / ("snapshot" + std::to_string(period) + ".json"));
+    EXPECT_EQ(util::readJsonFromFile(manifest_path.string())["period"].asUInt64(), period);
+  }
+}
+
 TEST_F(FullNodeTest, sync_five_nodes) {
   using namespace std;
 
@@ -1450,6 +1645,11 @@ TEST_F(FullNodeTest, light_node) {
     WAIT_EXPECT_EQ(ctx, nodes[0]->getPbftChain()->getPbftChainSizeExcludingEmptyPbftBlocks(),
                    nodes[1]->getPbftChain()->getPbftChainSizeExcludingEmptyPbftBlocks())
   });
+  EXPECT_HAPPENS({10s, 100ms}, [&](auto &ctx) {
+    // History is pruned in background, wait until pruner reaches the last scheduled period
+    const auto pruning_stats = nodes[1]->getDB()->getPruningStats();
+    WAIT_EXPECT_GE(ctx, pruning_stats.period_cursor, pruning_stats.period_target)
+  });
   uint32_t non_empty_counter = 0;
   for (uint64_t i = 0; i < nodes[1]->getPbftChain()->getPbftChainSize(); i++) {
     const auto pbft_block = nodes[1]->getDB()->getPbftBlock(i);
@@ -3,6 +3,7 @@
 #include <libdevcore/CommonJS.h>
 
 #include "network/rpc/eth/Eth.h"
+#include "network/rpc/jsonrpc_http_processor.hpp"
 #include "test_util/samples.hpp"
 
 namespace taraxa::core_tests {
@@ -252,6 +253,38 @@ TEST_F(RPCTest, eip_1898) {
   EXPECT_EQ(eth_json_rpc->eth_getBalance(from, "0x0"), eth_json_rpc->eth_getBalance(from, genesis_block));
 }
 
+TEST_F(RPCTest, http_malformed_batch) {
+  struct EchoHandler : jsonrpc::IClientConnectionHandler {
+    void HandleRequest(const std::string& request, std::string& response) override {
+      requests.push_back(request);
+      response = "{}";
+    }
+    std::vector<std::string> requests;
+  } handler;
+
+  auto processor = std::make_shared<net::JsonRpcHttpProcessor>();
+  processor->SetHandler(&handler);
+  uint32_t prefetched = 0;
+  processor->setBatchPrefetcher([&](const Json::Value&) { prefetched++; });
+
+  net::HttpProcessor::Request request;
+  request.method(boost::beast::http::verb::post);
+  for (const auto& body : {"[1,", "[", "[{\"id\": 1,"}) {
+    request.body() = body;
+    net::HttpProcessor::Response response;
+    EXPECT_NO_THROW(response = processor->process(request));
+    EXPECT_EQ(response.result(), boost::beast::http::status::ok);
+  }
+  // Malformed batches are passed to handler which reports parse error, but are not prefetched
+  EXPECT_EQ(handler.requests.size(), 3);
+  EXPECT_EQ(prefetched, 0);
+
+  request.body() = R"([{"jsonrpc":"2.0","id":1,"method":"eth_chainId","params":[]}])";
+  processor->process(request);
+  EXPECT_EQ(handler.requests.size(), 4);
+  EXPECT_EQ(prefetched, 1);
+}
+
 }  // namespace taraxa::core_tests
 
 using namespace taraxa;
@@ -201,7 +201,8 @@ TEST_F(StateAPITest, DISABLED_eth_mainnet_smoke) {
       progress_pct_log_threshold += 10;
     }
     auto const& test_block = test_blocks[blk_num];
-    SUT.execute_transactions(test_block.evm_block, test_block.transactions);
+    final_chain::TransactionReceipts receipts;
+    SUT.execute_transactions(test_block.evm_block, test_block.transactions, receipts);
     const auto& result = SUT.distribute_rewards({});
     ASSERT_EQ(result.state_root, test_block.state_root);
     SUT.transition_state_commit();
@@ -248,6 +249,40 @@ TEST_F(StateAPITest, slashing) {
   //  });
 }
 
+TEST_F(StateAPITest, receipts_decoding) {
+  std::vector<ExecutionResult> results(3);
+  results[0].gas_used = 21000;
+  results[1].gas_used = 100000;
+  results[1].new_contract_addr = addr_t::random();
+  results[1].logs = {{addr_t::random(), {h256::random(), h256::random()}, dev::fromHex("0x1234")},
+                     {addr_t::random(), {}, {}}};
+  results[2].gas_used = 30000;
+  results[2].code_err = "execution reverted";
+
+  dev::RLPStream encoding;
+  util::rlp_tuple(encoding, results);
+  final_chain::TransactionReceipts receipts;
+  decode_receipts(dev::bytesConstRef(&encoding.out()), receipts);
+
+  ASSERT_EQ(receipts.size(), results.size());
+  uint64_t cumulative_gas_used = 0;
+  for (size_t i = 0; i < results.size(); ++i) {
+    const auto& receipt = receipts[i];
+    EXPECT_EQ(receipt.gas_used, results[i].gas_used);
+    EXPECT_EQ(receipt.cumulative_gas_used, cumulative_gas_used += results[i].gas_used);
+    EXPECT_EQ(receipt.status_code, results[i].code_err.empty() ? 1 : 0);
+    ASSERT_EQ(receipt.logs.size(), results[i].logs.size());
+    for (size_t j = 0; j < receipt.logs.size(); ++j) {
+      EXPECT_EQ(receipt.logs[j].address, results[i].logs[j].address);
+      EXPECT_EQ(receipt.logs[j].topics, results[i].logs[j].topics);
+      EXPECT_EQ(receipt.logs[j].data, results[i].logs[j].data);
+    }
+  }
+  EXPECT_FALSE(receipts[0].new_contract_address);
+  EXPECT_EQ(receipts[1].new_contract_address, results[1].new_contract_addr);
+  EXPECT_FALSE(receipts[2].new_contract_address);
+}
+
 }  // namespace taraxa::state_api
 
 TARAXA_TEST_MAIN({})
@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 #include <libdevcore/CommonJS.h>
 
+#include <atomic>
 #include <thread>
 #include <vector>
 
@@ -464,6 +465,48 @@ TEST_F(TransactionTest, priority_queue_max_size) {
   }
 }
 
+TEST_F(TransactionTest, priority_queue_concurrent_insert) {
+  const uint32_t senders_count = 8;
+  const uint32_t trxs_per_sender = 50;
+  TransactionQueue priority_queue(nullptr);
+  std::vector<SharedTransactions> trxs(senders_count);
+  for (auto& sender_trxs : trxs) {
+    const auto sender_secret = dev::KeyPair::create().secret();
+    for (uint32_t nonce = 0; nonce < trxs_per_sender; ++nonce) {
+      sender_trxs.push_back(std::make_shared<Transaction>(nonce, 1, 1 + nonce % 7, 100, dev::bytes(), sender_secret,
+                                                          addr_t::random()));
+    }
+  }
+
+  // Every sender transactions are inserted by two threads at once, so each transaction is inserted only once
+  std::vector<std::thread> threads;
+  std::atomic<uint32_t> inserted = 0;
+  for (uint32_t i = 0; i < senders_count * 2; ++i) {
+    threads.emplace_back([&, i] {
+      for (auto trx : trxs[i / 2]) {
+        if (priority_queue.insert(std::move(trx), true, 1) == TransactionStatus::Inserted) {
+          inserted++;
+        }
+      }
+      priority_queue.getOrderedTransactions(trxs_per_sender);
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  EXPECT_EQ(inserted, senders_count * trxs_per_sender);
+  EXPECT_EQ(priority_queue.size(), senders_count * trxs_per_sender);
+  const auto all_trxs = priority_queue.getAllTransactions();
+  EXPECT_EQ(all_trxs.size(), senders_count);
+  for (const auto& sender_trxs : all_trxs) {
+    ASSERT_EQ(sender_trxs.size(), trxs_per_sender);
+    for (uint32_t nonce = 0; nonce < trxs_per_sender; ++nonce) {
+      EXPECT_EQ(sender_trxs[nonce]->getNonce(), nonce);
+    }
+  }
+}
+
 SharedTransactions generateRandomOrderTransactions(uint32_t size) {
   SharedTransactions trxs;
   std::vector<dev::KeyPair> kpv;
@@ -643,6 +686,21 @@ TEST_F(TransactionTest, typed_deserialization) {
   // shouldn't reach this code
   GTEST_FAIL();
 }
+
+TEST_F(TransactionTest, malformed_rlp_deserialization) {
+  // Valid RLP list, but not a transaction
+  const auto trx_rlp = dev::rlpList(1, 2, 3);
+  for (bool from_parsed_rlp : {false, true}) {
+    try {
+      from_parsed_rlp ? Transaction(dev::RLP(trx_rlp), true) : Transaction(trx_rlp, true);
+      ADD_FAILURE() << "malformed transaction was parsed";
+    } catch (const dev::RLPException& e) {
+      EXPECT_NE(std::string(e.what()).find("Can't parse transaction from RLP"), std::string::npos)
+          << "from_parsed_rlp: " << from_parsed_rlp;
+    }
+  }
+}
+
 TEST_F(TransactionTest, zero_gas_price_limit) {
   auto db = std::make_shared<DbStorage>(data_dir);
   auto cfg = node_cfgs.front();
@@ -714,6 +772,102 @@ TEST_F(TransactionTest, signature_performance) {
             << "ms" << std::endl;
 }
 
+TEST_F(TransactionTest, parallel_sender_recovery) {
+  auto db = std::make_shared<DbStorage>(data_dir);
+  auto cfg = node_cfgs.front();
+  cfg.transactions_sender_recovery_threads = 4;
+  TransactionManager trx_mgr(cfg, db, std::make_shared<final_chain::FinalChain>(db, cfg, addr_t{}), addr_t());
+
+  auto trxs = samples::createSignedTrxSamples(1, 1000, g_secret);
+  SharedTransactions trxs_from_rlp;
+  for (auto t : trxs) {
+    trxs_from_rlp.push_back(std::make_shared<Transaction>(t->rlp()));
+    EXPECT_FALSE(trxs_from_rlp.back()->isSenderRecovered());
+  }
+  trx_mgr.recoverSenders(trxs_from_rlp);
+  // Senders are recovered by the pool, getSender only reads the cached value
+  for (size_t i = 0; i < trxs.size(); ++i) {
+    EXPECT_TRUE(trxs_from_rlp[i]->isSenderRecovered());
+    EXPECT_EQ(trxs_from_rlp[i]->getSender(), g_key_pair->address());
+  }
+}
+
+TEST_F(TransactionTest, gas_estimation_cache) {
+  auto db = std::make_shared<DbStorage>(data_dir);
+  auto cfg = node_cfgs.front();
+  TransactionManager trx_mgr(cfg, db, std::make_shared<final_chain::FinalChain>(db, cfg, addr_t{}), addr_t());
+
+  SharedTransactions trxs;
+  for (size_t i = 0; i < 10; ++i) {
+    trxs.push_back(std::make_shared<Transaction>(i + 1, 100, 0, 200001, dev::fromHex(samples::greeter_contract_code),
+                                                 g_secret));
+  }
+  const auto estimations = trx_mgr.estimateTransactionsGas(trxs, 0);
+  EXPECT_EQ(trx_mgr.gasEstimationCacheStats().misses, trxs.size());
+  for (size_t i = 0; i < trxs.size(); ++i) {
+    EXPECT_GT(estimations[i], 0);
+    // Second estimation at the same period is served from cache
+    EXPECT_EQ(trx_mgr.estimateTransactionGas(trxs[i], 0), estimations[i]);
+  }
+  EXPECT_EQ(trx_mgr.gasEstimationCacheStats().misses, trxs.size());
+  EXPECT_EQ(trx_mgr.gasEstimationCacheStats().hits, trxs.size());
+}
+
+TEST_F(TransactionTest, pack_trxs_stops_estimation_at_weight_limit) {
+  auto db = std::make_shared<DbStorage>(data_dir);
+  auto cfg = node_cfgs.front();
+  TransactionManager trx_mgr(cfg, db, std::make_shared<final_chain::FinalChain>(db, cfg, addr_t{}), addr_t());
+
+  SharedTransactions trxs;
+  for (size_t i = 0; i < 200; ++i) {
+    trxs.push_back(std::make_shared<Transaction>(i + 1, 100, 0, 200001, dev::fromHex(samples::greeter_contract_code),
+                                                 g_secret));
+    trx_mgr.insertValidatedTransaction(std::shared_ptr<Transaction>(trxs.back()));
+  }
+  const auto estimation = trx_mgr.estimateTransactionGas(trxs.front(), 0);
+  ASSERT_GT(estimation, 0);
+
+  const auto [packed, estimations] = trx_mgr.packTrxs(0, estimation * 3);
+  EXPECT_EQ(packed.size(), 3);
+  EXPECT_EQ(estimations.size(), 3);
+  // Only transactions of the first estimated chunk are dry run
+  EXPECT_LT(trx_mgr.gasEstimationCacheStats().misses, trxs.size() / 2);
+
+  // Failed estimation is cached as well
+  auto failing_trx = std::make_shared<Transaction>(1, 100, 0, 200001, dev::fromHex("fe"), g_secret);
+  EXPECT_EQ(trx_mgr.estimateTransactionGas(failing_trx, 0), 0);
+  const auto misses = trx_mgr.gasEstimationCacheStats().misses;
+  EXPECT_EQ(trx_mgr.estimateTransactionGas(failing_trx, 0), 0);
+  EXPECT_EQ(trx_mgr.gasEstimationCacheStats().misses, misses);
+}
+
+TEST_F(TransactionTest, pool_journal_restore) {
+  auto db = std::make_shared<DbStorage>(data_dir);
+  auto cfg = node_cfgs.front();
+  cfg.transactions_pool_journal = true;
+  auto final_chain = std::make_shared<final_chain::FinalChain>(db, cfg, addr_t{});
+
+  auto trxs = samples::createSignedTrxSamples(1, 100, g_secret);
+  {
+    TransactionManager trx_mgr(cfg, db, final_chain, addr_t());
+    for (auto t : trxs) {
+      const auto status = trx_mgr.insertValidatedTransaction(std::move(t));
+      EXPECT_TRUE(status == TransactionStatus::Inserted || status == TransactionStatus::InsertedNonProposable);
+    }
+    // Transaction included in dag block is recovered as nonfinalized, not as pool transaction
+    trx_mgr.saveTransactionsFromDagBlock({trxs.front()});
+  }
+
+  TransactionManager trx_mgr(cfg, db, final_chain, addr_t());
+  trx_mgr.recoverNonfinalizedTransactions();
+  trx_mgr.restorePoolJournal();
+  EXPECT_EQ(trx_mgr.getNonfinalizedTrxSize(), 1);
+  EXPECT_EQ(trx_mgr.getTransactionPoolSize(), trxs.size() - 1);
+  for (size_t i = 1; i < trxs.size(); ++i) {
+    EXPECT_TRUE(trx_mgr.isTransactionKnown(trxs[i]->getHash()));
+  }
+}
+
 }  // namespace taraxa::core_tests
 
 using namespace taraxa;